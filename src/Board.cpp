@@ -1,11 +1,13 @@
 #include "Board.h"             // Подключаем заголовочный файл Board.h, содержащий объявление класса Board и перечисление CellState
 #include <iostream>            // Подключаем библиотеку для ввода/вывода (например, для отладки)
 #include <cmath>               // Подключаем математическую библиотеку (например, для функции std::abs)
+#include "Profiler.h"          // Подключаем замеры времени горячих путей (PROFILE_SCOPE)
 
 //
 // Конструктор класса Board
 //
-Board::Board(SDL_Texture* boardTexture, SDL_Texture* whitePieceTexture, SDL_Texture* blackPieceTexture,
+template <class Geometry>
+Board<Geometry>::Board(SDL_Texture* boardTexture, SDL_Texture* whitePieceTexture, SDL_Texture* blackPieceTexture,
              SDL_Texture* selectedW, SDL_Texture* selectedB,
              SDL_Texture* blackKing, SDL_Texture* blackKingS,
              SDL_Texture* whiteKing, SDL_Texture* whiteKingS)
@@ -25,14 +27,16 @@ Board::Board(SDL_Texture* boardTexture, SDL_Texture* whitePieceTexture, SDL_Text
 //
 // Метод для инициализации игрового поля
 //
-void Board::initBoard() {
-    for (int y = 0; y < 8; y++) {                   // Проходим по всем строкам игрового поля (8 строк)
-        for (int x = 0; x < 8; x++) {               // Проходим по всем столбцам игрового поля (8 столбцов)
-            if ((x + y) % 2 == 1) {                 // Если сумма координат нечетная – клетка "игровая" (обычно светлая)
-                if (y < 3)
-                    board[y][x] = white_checker;    // Если клетка находится в верхних 3 строках, ставим белую шашку
-                else if (y > 4)
-                    board[y][x] = black_checker;    // Если клетка находится в нижних 3 строках, ставим черную шашку
+template <class Geometry>
+void Board<Geometry>::initBoard() {
+    for (int y = 0; y < Geometry::SIZE; y++) {      // Проходим по всем строкам игрового поля
+        for (int x = 0; x < Geometry::SIZE; x++) {  // Проходим по всем столбцам игрового поля
+            if (Geometry::playable(x, y)) {         // Если сумма координат нечетная – клетка "игровая" (обычно светлая)
+                typename Geometry::Mask bit = Geometry::squareBit(x, y); // Бит клетки в масках начальной расстановки
+                if (Geometry::WHITE_START_MASK & bit)
+                    board[y][x] = white_checker;    // Если клетка входит в верхние PIECE_ROWS строк, ставим белую шашку
+                else if (Geometry::BLACK_START_MASK & bit)
+                    board[y][x] = black_checker;    // Если клетка входит в нижние PIECE_ROWS строк, ставим черную шашку
                 else
                     board[y][x] = empty;            // В остальных случаях клетка остается пустой
             } else {
@@ -45,21 +49,24 @@ void Board::initBoard() {
 //
 // Метод для получения состояния клетки по координатам (x, y)
 //
-int Board::getCell(int x, int y) const {
+template <class Geometry>
+int Board<Geometry>::getCell(int x, int y) const {
     return board[y][x];                           // Возвращаем значение из массива board по координатам y и x
 }
 
 //
 // Метод для установки состояния клетки по координатам (x, y)
 //
-void Board::setCell(int x, int y, int value) {
+template <class Geometry>
+void Board<Geometry>::setCell(int x, int y, int value) {
     board[y][x] = value;                          // Записываем новое значение в массив board по координатам y и x
 }
 
 //
 // Метод для выделения или снятия выделения с клетки (например, при выборе шашки)
 //
-void Board::selectCell(int x, int y, bool select) {
+template <class Geometry>
+void Board<Geometry>::selectCell(int x, int y, bool select) {
     if (select) {                                 // Если нужно выделить клетку
         if (board[y][x] == white_checker) board[y][x] = black_selected;  // Если в клетке белая шашка, меняем на состояние выделенной белой шашки
         else if (board[y][x] == black_checker) board[y][x] = white_selected; // Если в клетке черная шашка, меняем на состояние выделенной черной шашки
@@ -76,11 +83,27 @@ void Board::selectCell(int x, int y, bool select) {
 //
 // Метод для отрисовки игрового поля и шашек
 //
-void Board::draw(SDL_Renderer* renderer) {
-    SDL_RenderCopy(renderer, boardTexture, NULL, NULL);  // Рисуем игровое поле, используя текстуру boardTexture
+template <class Geometry>
+void Board<Geometry>::draw(SDL_Renderer* renderer) {
+    PROFILE_SCOPE("Board::draw");                    // Замер времени отрисовки поля
+    if (boardTexture) {
+        SDL_RenderCopy(renderer, boardTexture, NULL, NULL);  // Рисуем игровое поле, используя текстуру boardTexture
+    } else {                                         // Для доски без текстуры (например, 10x10) рисуем клетки прямоугольниками
+        for (int y = 0; y < Geometry::SIZE; y++) {
+            for (int x = 0; x < Geometry::SIZE; x++) {
+                Uint8 shade = Geometry::playable(x, y) ? 255 : 0; // Игровые клетки светлые, остальные темные, как на board.png
+                SDL_Rect cell = { x * Geometry::CELL_SIZE, y * Geometry::CELL_SIZE,
+                                  Geometry::CELL_SIZE, Geometry::CELL_SIZE };
+                SDL_SetRenderDrawColor(renderer, shade, shade, shade, 255);
+                SDL_RenderFillRect(renderer, &cell); // Закрашиваем клетку
+            }
+        }
+    }
 
-    for (int y = 0; y < 8; y++) {                    // Проходим по каждой строке игрового поля
-        for (int x = 0; x < 8; x++) {                // Проходим по каждому столбцу игрового поля
+    const int cellSize = Geometry::CELL_SIZE;        // Размер клетки для текущей геометрии
+    const int pieceRadius = Geometry::PIECE_RADIUS;  // Радиус шашки для текущей геометрии
+    for (int y = 0; y < Geometry::SIZE; y++) {       // Проходим по каждой строке игрового поля
+        for (int x = 0; x < Geometry::SIZE; x++) {   // Проходим по каждому столбцу игрового поля
             SDL_Texture* pieceTexture = nullptr;     // Инициализируем указатель на текстуру шашки как nullptr
             switch (board[y][x]) {                   // Выбираем текстуру в зависимости от состояния клетки
                 case white_checker: pieceTexture = whitePieceTexture; break;         // Белая шашка
@@ -95,10 +118,10 @@ void Board::draw(SDL_Renderer* renderer) {
             }
             if (pieceTexture) {                      // Если текстура для данной клетки определена (не nullptr)
                 SDL_Rect rect = {                    // Определяем прямоугольник для отрисовки шашки
-                    x * CELL_SIZE + (CELL_SIZE - PIECE_RADIUS * 2) / 2,  // Вычисляем координату X с учетом центра клетки
-                    y * CELL_SIZE + (CELL_SIZE - PIECE_RADIUS * 2) / 2,  // Вычисляем координату Y с учетом центра клетки
-                    PIECE_RADIUS * 2,               // Ширина прямоугольника равна диаметру шашки
-                    PIECE_RADIUS * 2                // Высота прямоугольника равна диаметру шашки
+                    x * cellSize + (cellSize - pieceRadius * 2) / 2,  // Вычисляем координату X с учетом центра клетки
+                    y * cellSize + (cellSize - pieceRadius * 2) / 2,  // Вычисляем координату Y с учетом центра клетки
+                    pieceRadius * 2,                // Ширина прямоугольника равна диаметру шашки
+                    pieceRadius * 2                 // Высота прямоугольника равна диаметру шашки
                 };
                 SDL_RenderCopy(renderer, pieceTexture, NULL, &rect); // Отрисовываем текстуру шашки в заданном прямоугольнике
             }
@@ -109,18 +132,47 @@ void Board::draw(SDL_Renderer* renderer) {
 //
 // Метод для проверки, нужно ли превратить шашку в дамку
 //
-void Board::checkForKing(int x, int y) {
+template <class Geometry>
+void Board<Geometry>::checkForKing(int x, int y) {
     int piece = board[y][x];                     // Получаем текущее состояние клетки (тип шашки)
-    if (piece == black_checker && y == 0)          // Если это черная шашка и она достигла верхней строки
+    typename Geometry::Mask bit = Geometry::squareBit(x, y); // Бит клетки в масках превращения
+    if (piece == black_checker && (Geometry::BLACK_PROMOTION_MASK & bit))      // Если это черная шашка и она достигла верхней строки
         board[y][x] = white_king;                // Превращаем ее в белую дамку (константа white_king)
-    else if (piece == white_checker && y == 7)     // Если это белая шашка и она достигла нижней строки
+    else if (piece == white_checker && (Geometry::WHITE_PROMOTION_MASK & bit)) // Если это белая шашка и она достигла нижней строки
         board[y][x] = black_king;                // Превращаем ее в черную дамку (константа black_king)
 }
 
+//
+// Метод для выполнения уже проверенного шага хода (свой ход, ход, принятый по сети, или ход из журнала)
+//
+template <class Geometry>
+void Board<Geometry>::applyMove(int fromX, int fromY, int toX, int toY, bool lastStep) {
+    int piece = board[fromY][fromX];             // Получаем шашку, которая делала ход (по ее исходной позиции)
+    if (std::abs(toX - fromX) >= 2) {            // Если ход перемещает шашку более чем на одну клетку (то есть захват)
+        int dx = (toX - fromX) / std::abs(toX - fromX); // Определяем направление по оси X (1 или -1)
+        int dy = (toY - fromY) / std::abs(toY - fromY); // Определяем направление по оси Y (1 или -1)
+        for (int i = 1; i < std::abs(toX - fromX); i++) { // Проходим по всем клеткам между начальной и целевой позицией
+            int cx = fromX + i * dx;             // Вычисляем текущую клетку по оси X
+            int cy = fromY + i * dy;             // Вычисляем текущую клетку по оси Y
+            int cellVal = board[cy][cx];         // Получаем содержимое текущей клетки
+            if (cellVal != empty && !isFriendly(cellVal, piece)) { // Если клетка занята вражеской шашкой
+                board[cy][cx] = empty;           // Удаляем вражескую шашку (захват)
+                break;                           // Прерываем цикл, так как враг найден
+            }
+        }
+    }
+    board[toY][toX] = piece;                     // Перемещаем шашку на целевую клетку
+    board[fromY][fromX] = empty;                 // Очищаем исходную клетку (где шашка была до хода)
+    selectCell(toX, toY, false);                 // Снимаем выделение с новой позиции шашки
+    if (lastStep || Geometry::PROMOTE_DURING_CAPTURE) // В русских шашках шашка становится дамкой и посреди взятия
+        checkForKing(toX, toY);                  // Проверяем, должна ли шашка превратиться в дамку после хода
+}
+
 //
 // Статический метод для проверки, принадлежат ли шашки одному игроку (друзья)
 //
-bool Board::isFriendly(int cell, int piece) {
+template <class Geometry>
+bool Board<Geometry>::isFriendly(int cell, int piece) {
     bool isWhite = (piece == white_checker || piece == black_selected ||
                     piece == black_king || piece == black_king_selected); // Определяем, является ли шашка белой (включая выделенные и дамки)
     if (isWhite)
@@ -134,15 +186,16 @@ bool Board::isFriendly(int cell, int piece) {
 //
 // Метод для проверки возможности захвата шашкой противника (для обычной шашки)
 //
-bool Board::canCapture(int x, int y, int piece) {
+template <class Geometry>
+bool Board<Geometry>::canCapture(int x, int y, int piece) {
     int directions[4][2] = { {-1, -1}, {1, -1}, {-1, 1}, {1, 1} }; // Массив направлений: все 4 диагональных направления
     for (int i = 0; i < 4; i++) {                 // Проходим по каждому направлению
         int midX = x + directions[i][0];         // Вычисляем координату средней клетки по X
         int midY = y + directions[i][1];         // Вычисляем координату средней клетки по Y
         int endX = x + directions[i][0] * 2;       // Вычисляем координату целевой клетки по X (через среднюю)
         int endY = y + directions[i][1] * 2;       // Вычисляем координату целевой клетки по Y (через среднюю)
-        if (midX < 0 || midX >= 8 || midY < 0 || midY >= 8) continue; // Если средняя клетка выходит за пределы доски, переходим к следующему направлению
-        if (endX < 0 || endX >= 8 || endY < 0 || endY >= 8) continue; // Если целевая клетка выходит за пределы доски, переходим к следующему направлению
+        if (!Geometry::inside(midX, midY)) continue; // Если средняя клетка выходит за пределы доски, переходим к следующему направлению
+        if (!Geometry::inside(endX, endY)) continue; // Если целевая клетка выходит за пределы доски, переходим к следующему направлению
         int middlePiece = getCell(midX, midY);     // Получаем состояние средней клетки
         int endCell = getCell(endX, endY);         // Получаем состояние целевой клетки
         bool isWhite = (piece == white_checker || piece == black_selected ||
@@ -164,7 +217,8 @@ bool Board::canCapture(int x, int y, int piece) {
 //
 // Метод для проверки возможности захвата дамкой противника
 //
-bool Board::canKingCapture(int x, int y, int piece) {
+template <class Geometry>
+bool Board<Geometry>::canKingCapture(int x, int y, int piece) {
     int directions[4][2] = { {1, 1}, {-1, 1}, {1, -1}, {-1, -1} }; // Массив направлений для дамки (все диагонали)
     for (int d = 0; d < 4; d++) {                // Проходим по каждому из направлений
         int dx = directions[d][0];              // Определяем смещение по X для данного направления
@@ -172,7 +226,7 @@ bool Board::canKingCapture(int x, int y, int piece) {
         int curX = x + dx;                      // Инициализируем текущую координату X
         int curY = y + dy;                      // Инициализируем текущую координату Y
         bool enemyFound = false;                // Флаг, указывающий, найден ли противник на пути дамки
-        while (curX >= 0 && curX < 8 && curY >= 0 && curY < 8) { // Пока текущие координаты находятся в пределах доски
+        while (Geometry::inside(curX, curY)) {  // Пока текущие координаты находятся в пределах доски
             int cellVal = getCell(curX, curY);  // Получаем состояние текущей клетки
             if (cellVal == empty) {             // Если клетка пуста
                 if (enemyFound)
@@ -194,3 +248,7 @@ bool Board::canKingCapture(int x, int y, int piece) {
     }
     return false;                               // Если ни в одном направлении захват не возможен, возвращаем false
 }
+
+// Явное инстанцирование для поддерживаемых вариантов доски
+template class Board<Russian8x8>;
+template class Board<International10x10>;
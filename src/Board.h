@@ -1,12 +1,9 @@
 #ifndef BOARD_H                   // Если макрос BOARD_H не определён, начинаем блок защиты от повторного включения
 #define BOARD_H                   // Определяем макрос BOARD_H для защиты от повторного включения
 
+#include "BoardGeometry.h"        // Подключаем описание геометрии доски (размеры, ряды и маски, вычисляемые при компиляции)
 #include <SDL2/SDL.h>             // Подключаем заголовочный файл SDL для работы с графическими примитивами и другими функциями SDL
 
-// Размер клетки и радиус шашки
-const int CELL_SIZE = 100;        // Определяем размер клетки игрового поля (100 пикселей)
-const int PIECE_RADIUS = 45;      // Определяем радиус шашки (45 пикселей)
-
 // Состояния клеток (шашки, выделение, дамки)
 enum CellState {                 
     black_cell = -1,              // -1: клетка, на которой нельзя располагать шашки (обычно тёмная клетка)
@@ -21,7 +18,9 @@ enum CellState {
     white_king_selected = 8       //  8: черная дамка, выделенная для хода
 };
 
-// Объявление класса Board, который управляет игровым полем и логикой шашек
+// Объявление шаблона класса Board, который управляет игровым полем и логикой шашек.
+// Geometry задаёт размер доски (Russian8x8 или International10x10), поэтому все границы известны при компиляции
+template <class Geometry>
 class Board {
 public:
     // Конструктор класса Board, принимает текстуры для игрового поля и шашек
@@ -38,11 +37,14 @@ public:
     void checkForKing(int x, int y); // Метод для проверки, нужно ли превратить шашку в дамку (если шашка достигла противоположной стороны)
     bool canCapture(int x, int y, int piece); // Метод для проверки возможности захвата шашкой противника (обычный захват)
     bool canKingCapture(int x, int y, int piece); // Метод для проверки возможности захвата дамкой противника
+    // Метод для выполнения уже проверенного шага хода (перемещение, снятие взятой шашки, превращение в дамку);
+    // lastStep — шаг завершает ход (в международных шашках дамкой становятся только в конце хода)
+    void applyMove(int fromX, int fromY, int toX, int toY, bool lastStep);
     static bool isFriendly(int cell, int piece); // Статический метод для проверки, принадлежат ли две шашки одному игроку (друзья)
 
 private:
-    int board[8][8];              // Двумерный массив, представляющий игровое поле (8x8 клеток), содержащий значения типа CellState
-    SDL_Texture* boardTexture;    // Текстура игрового поля
+    int board[Geometry::SIZE][Geometry::SIZE]; // Двумерный массив, представляющий игровое поле (SIZE x SIZE клеток), содержащий значения типа CellState
+    SDL_Texture* boardTexture;    // Текстура игрового поля (nullptr — поле рисуется прямоугольниками)
     SDL_Texture* whitePieceTexture; // Текстура белой шашки
     SDL_Texture* blackPieceTexture; // Текстура черной шашки
     SDL_Texture* selectedW;       // Текстура выделенной белой шашки
@@ -0,0 +1,78 @@
+#ifndef BOARDGEOMETRY_H            // Защита от повторного включения заголовочного файла
+#define BOARDGEOMETRY_H
+
+#include <cstdint>                 // Подключаем целочисленные типы фиксированного размера (uint32_t, uint64_t)
+#include <type_traits>             // Подключаем std::conditional для выбора типа маски на этапе компиляции
+
+// Маска игровых клеток в рядах [firstRow, lastRow) при rowSquares игровых клетках в ряду
+constexpr uint64_t rowsMask(int rowSquares, int firstRow, int lastRow) {
+    return ((uint64_t(1) << (lastRow * rowSquares)) - 1) & ~((uint64_t(1) << (firstRow * rowSquares)) - 1);
+}
+
+//
+// Геометрия доски: все размеры, ряды и маски вычисляются на этапе компиляции,
+// поэтому каждый вариант игры получает полностью специализированный код без проверок размера во время выполнения.
+//
+// Игровые клетки нумеруются построчно (индекс клетки = y * (Size / 2) + x / 2), это позволяет хранить
+// множество клеток в одной битовой маске: 32 бита для доски 8x8 и 50 бит для доски 10x10.
+//
+// InternationalRules включает правила международных шашек: обязательное взятие наибольшего количества шашек
+// и превращение в дамку только в конце хода (в русских шашках шашка превращается прямо во время взятия).
+//
+template <int Size, int PieceRows, int CellSize, bool InternationalRules>
+struct BoardGeometry {
+    static const int SIZE = Size;                       // Количество клеток по стороне доски
+    static const int PIECE_ROWS = PieceRows;            // Количество рядов, занятых шашками каждой стороны в начале партии
+    static const int CELL_SIZE = CellSize;              // Размер клетки на экране в пикселях
+    static const int PIECE_RADIUS = CellSize * 45 / 100; // Радиус шашки (45% размера клетки, как в исходной доске 8x8)
+    static const int SCREEN_SIZE = Size * CellSize;     // Размер окна, в которое помещается вся доска
+    static const int ROW_SQUARES = Size / 2;            // Количество игровых клеток в одном ряду
+    static const int SQUARES = Size * Size / 2;         // Общее количество игровых клеток
+
+    static const int WHITE_PROMOTION_ROW = Size - 1;    // Ряд, достигнув которого белая шашка становится дамкой
+    static const int BLACK_PROMOTION_ROW = 0;           // Ряд, достигнув которого черная шашка становится дамкой
+
+    static const bool MAJORITY_CAPTURE = InternationalRules;        // Обязательно взятие наибольшего количества шашек
+    static const bool PROMOTE_DURING_CAPTURE = !InternationalRules; // Шашка, дошедшая до последнего ряда во время взятия, продолжает бить как дамка
+
+    // Тип битовой маски игровых клеток: самый узкий тип, в который помещаются все клетки
+    typedef typename std::conditional<(SQUARES > 32), uint64_t, uint32_t>::type Mask;
+
+    static const Mask WHITE_START_MASK =                // Начальная расстановка белых (верхние ряды)
+        static_cast<Mask>(rowsMask(ROW_SQUARES, 0, PieceRows));
+    static const Mask BLACK_START_MASK =                // Начальная расстановка черных (нижние ряды)
+        static_cast<Mask>(rowsMask(ROW_SQUARES, Size - PieceRows, Size));
+    static const Mask WHITE_PROMOTION_MASK =            // Клетки превращения белых шашек в дамки
+        static_cast<Mask>(rowsMask(ROW_SQUARES, WHITE_PROMOTION_ROW, Size));
+    static const Mask BLACK_PROMOTION_MASK =            // Клетки превращения черных шашек в дамки
+        static_cast<Mask>(rowsMask(ROW_SQUARES, BLACK_PROMOTION_ROW, BLACK_PROMOTION_ROW + 1));
+
+    // Проверка, находится ли клетка в пределах доски (одно беззнаковое сравнение на координату)
+    static constexpr bool inside(int x, int y) {
+        return static_cast<unsigned>(x) < static_cast<unsigned>(Size) &&
+               static_cast<unsigned>(y) < static_cast<unsigned>(Size);
+    }
+
+    // Проверка, является ли клетка игровой (на ней могут стоять шашки)
+    static constexpr bool playable(int x, int y) {
+        return ((x + y) & 1) == 1;
+    }
+
+    // Индекс игровой клетки для битовой маски
+    static constexpr int squareIndex(int x, int y) {
+        return y * ROW_SQUARES + x / 2;
+    }
+
+    // Бит игровой клетки в маске
+    static constexpr Mask squareBit(int x, int y) {
+        return static_cast<Mask>(Mask(1) << squareIndex(x, y));
+    }
+};
+
+// Русские шашки: доска 8x8, по три ряда шашек, дамки ходят на любое расстояние
+typedef BoardGeometry<8, 3, 100, false> Russian8x8;
+
+// Международные шашки: доска 10x10, по четыре ряда шашек, дальнобойные дамки; клетка уменьшена, чтобы окно осталось 800x800
+typedef BoardGeometry<10, 4, 80, true> International10x10;
+
+#endif // BOARDGEOMETRY_H
@@ -0,0 +1,262 @@
+#include "Evaluator.h"             // Подключаем объявление класса Evaluator
+#include <SDL2/SDL.h>              // Подключаем SDL для определения возможностей процессора (SDL_HasAVX2, SDL_HasSSE41)
+#include <fstream>                 // Подключаем файловые потоки для чтения и записи весов
+#include <iostream>                // Подключаем вывод сообщений об ошибках
+#include <cstring>                 // Подключаем std::memcpy и std::memcmp
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define EVALUATOR_X86_KERNELS 1    // SIMD-ядра собираются только для x86 с компилятором GCC/Clang
+#include <immintrin.h>             // Подключаем интринсики SSE4.1 и AVX2
+#endif
+
+namespace {
+
+const char WEIGHTS_MAGIC[4] = { 'C', 'K', 'E', 'V' }; // Сигнатура файла весов
+const uint32_t WEIGHTS_VERSION = 1;                   // Версия формата файла весов
+
+// Заголовок файла весов; за ним следуют bias и таблицы весов для кодов фигур 1..4 по Geometry::SQUARES клеток
+struct WeightsHeader {
+    char magic[4];                 // Сигнатура "CKEV"
+    uint32_t version;              // Версия формата
+    uint32_t boardSize;            // Размер доски (8 или 10)
+    uint32_t squares;              // Количество игровых клеток
+};
+
+//
+// Скалярное ядро: по одному обращению к таблице весов на клетку
+//
+template <class PositionType, int Squares = PositionType::PADDED_SQUARES>
+void evaluateScalar(const float (*weights)[Squares], float bias,
+                    const PositionType* positions, int count, float* scores) {
+    for (int i = 0; i < count; i++) {
+        const int8_t* cells = positions[i].squares;     // Клетки i-й позиции
+        float score = bias;
+        for (int sq = 0; sq < Squares; sq++)
+            score += weights[cells[sq]][sq];            // Строка piece_none нулевая, поэтому пустые клетки ничего не добавляют
+        scores[i] = (positions[i].sideToMove == white_checker) ? score : -score; // Оценка с точки зрения стороны, которая ходит
+    }
+}
+
+#ifdef EVALUATOR_X86_KERNELS
+
+//
+// SIMD-ядра работают с пакетом позиций "поперек": в каждой линии вектора своя позиция.
+// Для каждой клетки веса всех кодов фигур лежат рядом (squareWeights[клетка][код]),
+// поэтому вес выбирается одной перестановкой внутри регистра по коду фигуры, без условных переходов.
+//
+
+//
+// Ядро SSE4.1: 4 позиции за проход, выбор веса байтовой перестановкой pshufb
+//
+template <class PositionType, int Squares = PositionType::PADDED_SQUARES>
+__attribute__((target("sse4.1")))
+int evaluateSse41(const float (*squareWeights)[8], float bias,
+                  const PositionType* positions, int count, float* scores) {
+    // Код фигуры -> номер первого байта веса в таблице кодов 1..4; для пустой клетки старший бит обнуляет результат
+    const __m128i codeToByte = _mm_setr_epi8(-128, 0, 4, 8, 12, -128, -128, -128,
+                                             -128, -128, -128, -128, -128, -128, -128, -128);
+    const __m128i byteOffsets = _mm_set1_epi32(0x03020100);                 // Смещения байтов внутри float
+    const __m128i lowByte = _mm_set1_epi32(0xFF);
+    const __m128i spread = _mm_set1_epi32(0x01010101);
+    const __m128i whiteSide = _mm_set1_epi32(white_checker);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 acc[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+        for (int sq = 0; sq < Squares; sq += 4) {
+            int32_t packed[4];                                              // Коды четырех клеток каждой из четырех позиций
+            for (int lane = 0; lane < 4; lane++)
+                std::memcpy(&packed[lane], positions[i + lane].squares + sq, sizeof(int32_t));
+            __m128i codes = _mm_shuffle_epi8(codeToByte,                   // Коды фигур сразу заменяем номерами байтов весов
+                                             _mm_loadu_si128(reinterpret_cast<const __m128i*>(packed)));
+            for (int j = 0; j < 4; j++) {
+                // Размножаем байт j каждой линии на всю линию умножением и добавляем смещения байтов внутри float
+                __m128i index = _mm_add_epi8(_mm_mullo_epi32(_mm_and_si128(_mm_srli_epi32(codes, 8 * j), lowByte), spread),
+                                             byteOffsets);
+                __m128i table = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&squareWeights[sq + j][1])); // Веса кодов 1..4
+                acc[j] = _mm_add_ps(acc[j], _mm_castsi128_ps(_mm_shuffle_epi8(table, index)));
+            }
+        }
+        __m128 score = _mm_add_ps(_mm_set1_ps(bias), _mm_add_ps(_mm_add_ps(acc[0], acc[1]), _mm_add_ps(acc[2], acc[3])));
+        __m128i sides = _mm_setr_epi32(positions[i].sideToMove, positions[i + 1].sideToMove,
+                                       positions[i + 2].sideToMove, positions[i + 3].sideToMove);
+        __m128 flip = _mm_andnot_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(sides, whiteSide)), _mm_set1_ps(-0.0f)); // Знак для черных
+        _mm_storeu_ps(scores + i, _mm_xor_ps(score, flip));
+    }
+    return i;                      // Количество обработанных позиций; остаток досчитывается скалярно
+}
+
+//
+// Ядро AVX2: 8 позиций за проход, коды собираются одной инструкцией gather, вес выбирается перестановкой vpermps
+//
+template <class PositionType, int Squares = PositionType::PADDED_SQUARES>
+__attribute__((target("avx2")))
+int evaluateAvx2(const float (*squareWeights)[8], float bias,
+                 const PositionType* positions, int count, float* scores) {
+    const __m256i offsets = _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7),
+                                               _mm256_set1_epi32(sizeof(PositionType))); // Смещения позиций пакета в байтах
+    const __m256i lowByte = _mm256_set1_epi32(0xFF);
+    const __m256i whiteSide = _mm256_set1_epi32(white_checker);
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 acc[4] = { _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps(), _mm256_setzero_ps() };
+        for (int sq = 0; sq < Squares; sq += 4) {
+            __m256i codes = _mm256_i32gather_epi32(                     // Коды клеток sq..sq+3 восьми позиций
+                reinterpret_cast<const int*>(positions[i].squares + sq), offsets, 1);
+            for (int j = 0; j < 4; j++) {
+                __m256i code = _mm256_and_si256(_mm256_srli_epi32(codes, 8 * j), lowByte); // Код клетки sq + j
+                acc[j] = _mm256_add_ps(acc[j], _mm256_permutevar8x32_ps(_mm256_loadu_ps(squareWeights[sq + j]), code));
+            }
+        }
+        __m256 score = _mm256_add_ps(_mm256_set1_ps(bias),
+                                     _mm256_add_ps(_mm256_add_ps(acc[0], acc[1]), _mm256_add_ps(acc[2], acc[3])));
+        __m256i sides = _mm256_i32gather_epi32(&positions[i].sideToMove, offsets, 1);
+        __m256 flip = _mm256_andnot_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(sides, whiteSide)), _mm256_set1_ps(-0.0f));
+        _mm256_storeu_ps(scores + i, _mm256_xor_ps(score, flip));
+    }
+    return i;                      // Количество обработанных позиций; остаток досчитывается скалярно
+}
+
+#endif // EVALUATOR_X86_KERNELS
+
+} // namespace
+
+//
+// Конструктор: веса по умолчанию — материал (шашка 100, дамка 300) и небольшой бонус за продвижение шашки
+//
+template <class Geometry>
+Evaluator<Geometry>::Evaluator()
+    : bias(0.0f), kernel(bestKernel())
+{
+    std::memset(weights, 0, sizeof(weights));                    // Все веса (включая дополнение) нулевые
+    for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+        int row = PositionType::squareY(sq);                     // Ряд клетки
+        weights[piece_white_man][sq] = 100.0f + 2.0f * row;      // Белые шашки идут вниз, к последнему ряду
+        weights[piece_black_man][sq] = -(100.0f + 2.0f * (Geometry::SIZE - 1 - row)); // Черные шашки идут вверх
+        weights[piece_white_king][sq] = 300.0f;                  // Белая дамка
+        weights[piece_black_king][sq] = -300.0f;                 // Черная дамка
+    }
+    updateSquareWeights();
+}
+
+//
+// Загрузка весов из бинарного файла (little-endian: заголовок, bias, 4 таблицы по Geometry::SQUARES чисел float)
+//
+template <class Geometry>
+bool Evaluator<Geometry>::loadWeights(const std::string& path) {
+    std::ifstream file(path.c_str(), std::ios::binary);          // Открываем файл в двоичном режиме
+    if (!file) {
+        std::cout << "Не удалось открыть файл весов: " << path << std::endl;
+        return false;
+    }
+    WeightsHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header)); // Читаем заголовок
+    if (!file || std::memcmp(header.magic, WEIGHTS_MAGIC, sizeof(WEIGHTS_MAGIC)) != 0 ||
+        header.version != WEIGHTS_VERSION) {
+        std::cout << "Неверный формат файла весов: " << path << std::endl;
+        return false;
+    }
+    if (header.boardSize != static_cast<uint32_t>(Geometry::SIZE) ||
+        header.squares != static_cast<uint32_t>(Geometry::SQUARES)) {
+        std::cout << "Файл весов предназначен для доски " << header.boardSize << "x" << header.boardSize << std::endl;
+        return false;
+    }
+    float loaded[PIECE_CODES][SQUARES];                          // Читаем во временный буфер, чтобы не испортить веса при ошибке
+    std::memset(loaded, 0, sizeof(loaded));
+    float loadedBias = 0.0f;
+    file.read(reinterpret_cast<char*>(&loadedBias), sizeof(loadedBias));
+    for (int piece = 1; piece < PIECE_CODES; piece++)
+        file.read(reinterpret_cast<char*>(loaded[piece]), Geometry::SQUARES * sizeof(float));
+    if (!file) {
+        std::cout << "Файл весов обрезан: " << path << std::endl;
+        return false;
+    }
+    std::memcpy(weights, loaded, sizeof(weights));
+    bias = loadedBias;
+    updateSquareWeights();
+    return true;
+}
+
+//
+// Сохранение весов в бинарный файл в том же формате
+//
+template <class Geometry>
+bool Evaluator<Geometry>::saveWeights(const std::string& path) const {
+    std::ofstream file(path.c_str(), std::ios::binary | std::ios::trunc);
+    if (!file) {
+        std::cout << "Не удалось создать файл весов: " << path << std::endl;
+        return false;
+    }
+    WeightsHeader header;
+    std::memcpy(header.magic, WEIGHTS_MAGIC, sizeof(WEIGHTS_MAGIC));
+    header.version = WEIGHTS_VERSION;
+    header.boardSize = Geometry::SIZE;
+    header.squares = Geometry::SQUARES;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+    for (int piece = 1; piece < PIECE_CODES; piece++)
+        file.write(reinterpret_cast<const char*>(weights[piece]), Geometry::SQUARES * sizeof(float));
+    return static_cast<bool>(file);
+}
+
+//
+// Перестроение транспонированной копии весов: для каждой клетки веса всех кодов фигур подряд
+//
+template <class Geometry>
+void Evaluator<Geometry>::updateSquareWeights() {
+    std::memset(squareWeights, 0, sizeof(squareWeights));
+    for (int sq = 0; sq < SQUARES; sq++) {
+        for (int piece = 0; piece < PIECE_CODES; piece++)
+            squareWeights[sq][piece] = weights[piece][sq];
+    }
+}
+
+//
+// Оценка одной позиции (скалярно: для одной позиции накладные расходы SIMD не окупаются)
+//
+template <class Geometry>
+float Evaluator<Geometry>::evaluate(const PositionType& position) const {
+    float score;
+    evaluateScalar(weights, bias, &position, 1, &score);
+    return score;
+}
+
+//
+// Пакетная оценка позиций выбранным ядром
+//
+template <class Geometry>
+void Evaluator<Geometry>::evaluateBatch(const PositionType* positions, int count, float* scores) const {
+    if (count <= 0) return;
+    int done = 0;                                                // Количество позиций, оцененных SIMD-ядром
+#ifdef EVALUATOR_X86_KERNELS
+    if (kernel == kernel_avx2)
+        done = evaluateAvx2(squareWeights, bias, positions, count, scores);
+    else if (kernel == kernel_sse41)
+        done = evaluateSse41(squareWeights, bias, positions, count, scores);
+#endif
+    evaluateScalar(weights, bias, positions + done, count - done, scores + done); // Остаток пакета (или весь пакет)
+}
+
+//
+// Выбор лучшего ядра по возможностям процессора
+//
+template <class Geometry>
+typename Evaluator<Geometry>::Kernel Evaluator<Geometry>::bestKernel() {
+#ifdef EVALUATOR_X86_KERNELS
+    if (SDL_HasAVX2()) return kernel_avx2;                       // Процессор поддерживает AVX2
+    if (SDL_HasSSE41()) return kernel_sse41;                     // Процессор поддерживает SSE4.1
+#endif
+    return kernel_scalar;                                        // Иначе используем скалярную версию
+}
+
+template <class Geometry>
+const char* Evaluator<Geometry>::kernelName(Kernel value) {
+    switch (value) {
+        case kernel_avx2: return "AVX2";
+        case kernel_sse41: return "SSE4.1";
+        default: return "scalar";
+    }
+}
+
+// Явное инстанцирование для поддерживаемых вариантов доски
+template class Evaluator<Russian8x8>;
+template class Evaluator<International10x10>;
@@ -0,0 +1,56 @@
+#ifndef EVALUATOR_H                // Защита от повторного включения заголовочного файла
+#define EVALUATOR_H
+
+#include "Position.h"              // Подключаем компактную позицию движка
+#include <string>                  // Подключаем std::string для путей к файлам весов
+
+//
+// Обучаемая оценка позиции: линейная модель по признакам "фигура на клетке" (piece-square).
+// Оценка = bias + сумма весов weights[код фигуры][клетка] по всем клеткам; положительные значения хороши для белых.
+//
+// Пакетная оценка выполняется SIMD-ядрами (AVX2 или SSE4.1), по одной позиции в каждой линии вектора;
+// ядро выбирается во время выполнения по возможностям процессора, иначе используется скалярная версия.
+//
+template <class Geometry>
+class Evaluator {
+public:
+    typedef Position<Geometry> PositionType;                      // Тип позиции для данной геометрии
+    static const int SQUARES = PositionType::PADDED_SQUARES;      // Количество клеток в таблицах весов (с выравниванием)
+
+    // Реализации пакетной оценки
+    enum Kernel {
+        kernel_scalar,             // Скалярная реализация (работает везде)
+        kernel_sse41,              // SSE4.1: 4 позиции за проход
+        kernel_avx2                // AVX2: 8 позиций за проход
+    };
+
+    Evaluator();                   // Конструктор: веса по умолчанию (материал и продвижение шашек), лучшее доступное ядро
+
+    bool loadWeights(const std::string& path);       // Загрузка весов из бинарного файла; возвращает false при ошибке
+    bool saveWeights(const std::string& path) const; // Сохранение весов в бинарный файл; возвращает false при ошибке
+
+    float evaluate(const PositionType& position) const; // Оценка одной позиции с точки зрения стороны, которая ходит
+    void evaluateBatch(const PositionType* positions, int count, float* scores) const; // Оценка пакета позиций
+
+    float getWeight(int piece, int square) const { return weights[piece][square]; } // Вес фигуры (PieceCode) на клетке
+    void setWeight(int piece, int square, float value) {                             // Установка веса
+        weights[piece][square] = value;
+        squareWeights[square][piece] = value;         // Транспонированная копия для SIMD-ядер
+    }
+    float getBias() const { return bias; }            // Свободный член модели
+    void setBias(float value) { bias = value; }       // Установка свободного члена
+
+    Kernel getKernel() const { return kernel; }       // Текущее ядро пакетной оценки
+    void setKernel(Kernel value) { kernel = value; }  // Принудительный выбор ядра (например, для сравнения в бенчмарке)
+    static Kernel bestKernel();                       // Лучшее ядро, поддерживаемое процессором
+    static const char* kernelName(Kernel value);      // Название ядра для вывода
+
+private:
+    void updateSquareWeights();    // Перестроение транспонированной копии весов после загрузки
+    alignas(32) float weights[PIECE_CODES][SQUARES]; // Таблицы весов; строка piece_none и клетки дополнения всегда нулевые
+    alignas(32) float squareWeights[SQUARES][8];     // Те же веса по клеткам: squareWeights[клетка][код фигуры] (для SIMD-ядер)
+    float bias;                    // Свободный член модели
+    Kernel kernel;                 // Выбранное ядро пакетной оценки
+};
+
+#endif // EVALUATOR_H
@@ -2,28 +2,31 @@
 #include <SDL2/SDL_image.h>              // Подключаем библиотеку SDL_image для загрузки изображений
 #include <iostream>                      // Подключаем библиотеку для ввода/вывода (std::cout, std::cin)
 #include <cmath>                         // Подключаем математическую библиотеку (для функции std::abs и др.)
+#include "Profiler.h"                    // Подключаем замеры времени горячих путей (PROFILE_SCOPE) и сохранение трассы
 
-// Размеры экрана
-const int SCREEN_WIDTH = 800;            // Определяем ширину окна приложения (800 пикселей)
-const int SCREEN_HEIGHT = 800;           // Определяем высоту окна приложения (800 пикселей)
+static const uint64_t JOURNAL_COMPACT_RECORDS = 1000; // Через сколько записей журнала сохраняется снимок партий
 
-Game::Game()
+template <class Geometry>
+Game<Geometry>::Game()
     : window(nullptr), renderer(nullptr),
       boardTexture(nullptr), whitePieceTexture(nullptr), blackPieceTexture(nullptr),
       selectedW(nullptr), selectedB(nullptr),  //пусто
       blackKing(nullptr), blackKingS(nullptr), whiteKing(nullptr), whiteKingS(nullptr),
-      board(nullptr), networkManager(nullptr),
-      currentTurn(0), localPlayer(0), networkMode(false),
-      selected(false), selectedX(0), selectedY(0)
+      board(nullptr), networkManager(nullptr), journal(nullptr), gameId(0),
+      traceFile("checkers-trace.json"), traceOnExit(false),
+      currentTurn(0), localPlayer(0), mode(3), networkMode(false),
+      selected(false), selectedX(0), selectedY(0), jumpsMade(0)
 {
     // Конструктор класса Game: инициализирует все указатели и переменные начальными значениями
 }
 
-Game::~Game() {
+template <class Geometry>
+Game<Geometry>::~Game() {
     close();                            // Деструктор класса Game: освобождает ресурсы, вызывая метод close()
 }
 
-SDL_Texture* Game::loadTexture(const char* path) {
+template <class Geometry>
+SDL_Texture* Game<Geometry>::loadTexture(const char* path) {
     SDL_Surface* surface = IMG_Load(path);  // Загружаем изображение по указанному пути в поверхность SDL_Surface
     if (!surface) {                          // Если загрузка изображения не удалась
         std::cout << "Ошибка загрузки текстуры: " << path << " | " << IMG_GetError() << std::endl; // Выводим сообщение об ошибке
@@ -34,14 +37,15 @@ SDL_Texture* Game::loadTexture(const char* path) {
     return texture;                          // Возвращаем созданную текстуру
 }
 
-bool Game::init() {
+template <class Geometry>
+bool Game<Geometry>::init() {
     if (SDL_Init(SDL_INIT_VIDEO) < 0) {       // Инициализируем подсистему видео SDL; если возникла ошибка
         std::cout << "Ошибка SDL: " << SDL_GetError() << std::endl;  // Выводим сообщение об ошибке
         return false;                       // Завершаем инициализацию, возвращая false
     }
     
     window = SDL_CreateWindow("Checkers", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED,
-                              SCREEN_WIDTH, SCREEN_HEIGHT, SDL_WINDOW_SHOWN);  // Создаем окно с заголовком "Checkers", расположенное по центру экрана
+                              Geometry::SCREEN_SIZE, Geometry::SCREEN_SIZE, SDL_WINDOW_SHOWN);  // Создаем окно с заголовком "Checkers", расположенное по центру экрана
     if (!window) return false;               // Если окно не создано, возвращаем false
     
     renderer = SDL_CreateRenderer(window, -1, SDL_RENDERER_ACCELERATED);  // Создаем рендерер с аппаратным ускорением для окна
@@ -50,7 +54,8 @@ bool Game::init() {
     if (!(IMG_Init(IMG_INIT_PNG) & IMG_INIT_PNG)) return false;  // Инициализируем SDL_image для работы с PNG; если не удалось — возвращаем false
     
     // Загружаем текстуры для элементов игры
-    boardTexture = loadTexture("board.png");           // Загружаем текстуру игрового поля
+    if (Geometry::SIZE == 8)
+        boardTexture = loadTexture("board.png");       // Загружаем текстуру игрового поля (нарисована для доски 8x8, другие доски рисуются прямоугольниками)
     whitePieceTexture = loadTexture("white_piece.png");  // Загружаем текстуру белой шашки
     blackPieceTexture = loadTexture("black_piece.png");  // Загружаем текстуру черной шашки
     selectedW = loadTexture("white_piece_s.png");        // Загружаем текстуру выделенной белой шашки
@@ -60,22 +65,21 @@ bool Game::init() {
     whiteKing = loadTexture("white_king.png");           // Загружаем текстуру белой дамки
     whiteKingS = loadTexture("white_king_s.png");        // Загружаем текстуру выделенной белой дамки
     
-    if (!boardTexture || !whitePieceTexture || !blackPieceTexture ||
+    if ((Geometry::SIZE == 8 && !boardTexture) || !whitePieceTexture || !blackPieceTexture ||
         !selectedW || !selectedB || !blackKing || !blackKingS ||
         !whiteKing || !whiteKingS) {        // Проверяем, что все текстуры успешно загружены
         return false;                      // Если какая-либо текстура не загружена, возвращаем false
     }
     
     // Выбор режима игры (сетевая игра или локальная игра)
-    std::cout << "Выберите режим:\n1 - Сервер\n2 - Клиент\n3 - Локальная игра\nВаш выбор: ";
-    int mode;
+    std::cout << "Выберите режим:\n1 - Сервер\n2 - Клиент\n3 - Локальная игра\n4 - Подбор соперника\nВаш выбор: ";
     std::cin >> mode;                      // Считываем выбор режима из консоли
     
     if (mode == 1) {                       // Если выбран режим сервера
         networkMode = true;                // Устанавливаем, что игра в сетевом режиме
         localPlayer = white_checker;       // Сервер играет белыми (используем константу white_checker)
         networkManager = new NetworkManager(); // Создаем объект сетевого менеджера
-        if (!networkManager->initServer()) return false; // Инициализируем сервер; если не удалось — возвращаем false
+        if (!networkManager->initServer(Geometry::SIZE)) return false; // Инициализируем сервер и сверяем размер доски с клиентом; если не удалось — возвращаем false
     } else if (mode == 2) {                // Если выбран режим клиента
         networkMode = true;                // Устанавливаем, что игра в сетевом режиме
         localPlayer = black_checker;       // Клиент играет черными (используем константу black_checker)
@@ -83,8 +87,19 @@ bool Game::init() {
         std::string serverIP;
         std::cout << "Введите IP сервера: "; // Просим пользователя ввести IP адрес сервера
         std::cin >> serverIP;              // Считываем IP адрес сервера
-        if (!networkManager->initClient(serverIP)) return false; // Инициализируем клиент; если не удалось — возвращаем false
+        if (!networkManager->initClient(serverIP, Geometry::SIZE)) return false; // Инициализируем клиент и сверяем размер доски с сервером; если не удалось — возвращаем false
+    } else if (mode == 4) {                // Если выбран подбор соперника через сервер подбора (checkers-lobby)
+        networkMode = true;                // Устанавливаем, что игра в сетевом режиме
+        networkManager = new NetworkManager(); // Создаем объект сетевого менеджера
+        std::string serverIP;
+        int rating;
+        std::cout << "Введите IP сервера подбора: "; // Просим пользователя ввести IP адрес сервера подбора
+        std::cin >> serverIP;              // Считываем IP адрес сервера подбора
+        std::cout << "Введите ваш рейтинг: "; // Соперник подбирается с близким рейтингом
+        std::cin >> rating;                // Считываем рейтинг
+        if (!networkManager->initMatchmaking(serverIP, Geometry::SIZE, rating, localPlayer)) return false; // Сторону (белые или черные) назначает сервер
     } else {                               // Если выбран локальный режим игры
+        mode = 3;                          // Любой другой ввод считается локальной игрой (так режим и пишется в журнал)
         networkMode = false;               // Устанавливаем, что сетевой режим не используется
     }
     
@@ -92,221 +107,230 @@ bool Game::init() {
     currentTurn = white_checker;           // Инициализируем текущий ход, используя константу white_checker
     
     // Создаем объект игрового поля, передавая необходимые текстуры
-    board = new Board(boardTexture, whitePieceTexture, blackPieceTexture,
-                      selectedW, selectedB, blackKing, blackKingS, whiteKing, whiteKingS);
+    board = new Board<Geometry>(boardTexture, whitePieceTexture, blackPieceTexture,
+                                selectedW, selectedB, blackKing, blackKingS, whiteKing, whiteKingS);
+    
+    if (!journalDirectory.empty() && !openJournal()) return false; // Если журнал включен, восстанавливаем из него незавершенную партию
+    beginTurn();                           // Допустимые ходы первой очереди (или продолжение восстановленного взятия)
     
     return true;                           // Возвращаем true, сигнализируя об успешной инициализации игры
 }
 
-void Game::handleMouseClick(int x, int y) {
+template <class Geometry>
+void Game<Geometry>::handleMouseClick(int x, int y) {
+    PROFILE_SCOPE("Game::handleMouseClick"); // Замер времени обработки клика
     // Если игра в сетевом режиме и сейчас не наш ход, клик игнорируется
     if (networkMode && currentTurn != localPlayer)
         return;
     
-    int cellX = x / CELL_SIZE;           // Определяем индекс клетки по оси X, исходя из координаты клика и размера клетки
-    int cellY = y / CELL_SIZE;           // Определяем индекс клетки по оси Y
+    int cellX = x / Geometry::CELL_SIZE; // Определяем индекс клетки по оси X, исходя из координаты клика и размера клетки
+    int cellY = y / Geometry::CELL_SIZE; // Определяем индекс клетки по оси Y
+    if (!Geometry::inside(cellX, cellY)) return; // Клик за пределами доски игнорируется
     
     if (!selected) {                     // Если шашка еще не выбрана
-        int piece = board->getCell(cellX, cellY); // Получаем содержимое клетки (тип шашки или пустая клетка)
-        if (!networkMode) {              // Если игра локальная
-            if ((currentTurn == white_checker &&
-                (piece == white_checker || piece == black_selected || piece == black_king || piece == black_king_selected)) ||
-                (currentTurn == black_checker &&
-                (piece == black_checker || piece == white_selected || piece == white_king || piece == white_king_selected))) {
-                board->selectCell(cellX, cellY, true); // Выделяем выбранную шашку
-                selected = true;         // Устанавливаем флаг, что шашка выбрана
-                selectedX = cellX;       // Запоминаем индекс X выбранной клетки
-                selectedY = cellY;       // Запоминаем индекс Y выбранной клетки
-            }
-        } else {                         // Если игра в сетевом режиме
-            if ((localPlayer == white_checker &&
-                (piece == white_checker || piece == black_selected || piece == black_king || piece == black_king_selected)) ||
-                (localPlayer == black_checker &&
-                (piece == black_checker || piece == white_selected || piece == white_king || piece == white_king_selected))) {
-                board->selectCell(cellX, cellY, true); // Выделяем шашку, если она принадлежит локальному игроку
-                selected = true;         // Устанавливаем флаг выбора
-                selectedX = cellX;       // Запоминаем координату X выбранной шашки
-                selectedY = cellY;       // Запоминаем координату Y выбранной шашки
-            }
-        }
-    } else {                             // Если шашка уже выбрана — обрабатываем попытку хода
-        int dx = cellX - selectedX;      // Вычисляем смещение по оси X от исходной позиции
-        int dy = cellY - selectedY;      // Вычисляем смещение по оси Y от исходной позиции
-        int piece = board->getCell(selectedX, selectedY); // Получаем тип шашки, которую пытаемся переместить
-        int fromX = selectedX, fromY = selectedY; // Запоминаем начальные координаты выбранной шашки
-        
-        // Ход для дамки (шашки, ставшие дамками)
-        if ((piece == black_king || piece == white_king ||
-            piece == black_king_selected || piece == white_king_selected) &&
-           (std::abs(dx) == std::abs(dy)) && std::abs(dx) >= 1) { // Проверяем, что ход по диагонали и длина хода не меньше 1
-            
-           if (board->getCell(cellX, cellY) != empty) { // Если целевая клетка не пуста
-               board->selectCell(selectedX, selectedY, false); // Снимаем выделение с исходной клетки
-               selected = false;         // Сбрасываем флаг выбора шашки
-               return;                   // Прерываем выполнение функции, так как ход невозможен
-           }
-           
-           int stepX = (dx > 0) ? 1 : -1;  // Определяем направление перемещения по оси X (вправо или влево)
-           int stepY = (dy > 0) ? 1 : -1;  // Определяем направление перемещения по оси Y (вниз или вверх)
-           int distance = std::abs(dx);    // Вычисляем расстояние хода (количество клеток)
-           int enemyCount = 0;             // Инициализируем счетчик противников, встреченных на пути
-           int enemyX = -1, enemyY = -1;   // Инициализируем координаты противника (-1 означает, что противник не найден)
-           
-           for (int i = 1; i < distance; i++) {  // Проходим по всем клеткам между начальной и целевой позицией
-               int curX = selectedX + i * stepX;   // Вычисляем текущую клетку по оси X
-               int curY = selectedY + i * stepY;   // Вычисляем текущую клетку по оси Y
-               int cellVal = board->getCell(curX, curY); // Получаем содержимое текущей клетки
-               if (cellVal != empty) {         // Если клетка не пуста
-                   if (Board::isFriendly(cellVal, piece)) { // Если шашка в клетке принадлежит тому же игроку
-                       enemyCount = 2;       // Устанавливаем enemyCount в 2, что означает невозможность хода
-                       break;                // Прерываем цикл
-                   } else {
-                       enemyCount++;         // Увеличиваем счетчик противников
-                       enemyX = curX;        // Запоминаем координату X противника
-                       enemyY = curY;        // Запоминаем координату Y противника
-                   }
-               }
-           }
-           
-           if (enemyCount > 1) {            // Если на пути встречено более одного противника
-               board->selectCell(selectedX, selectedY, false); // Снимаем выделение с выбранной шашки
-               selected = false;            // Сбрасываем флаг выбора
-               return;                      // Ход невозможен, выходим из функции
-           }
-           
-           if (enemyCount == 0) {           // Если противников не найдено — выполняем обычный ход дамкой
-               board->setCell(cellX, cellY, piece); // Устанавливаем шашку на целевую клетку
-               board->setCell(selectedX, selectedY, empty); // Очищаем исходную клетку
-               board->selectCell(cellX, cellY, false); // Снимаем выделение с новой позиции шашки
-               selected = false;            // Сбрасываем флаг выбора
-               currentTurn = (currentTurn == white_checker) ? black_checker : white_checker; // Меняем ход игрока
-               if (networkMode)
-                   networkManager->sendMove(fromX, fromY, cellX, cellY, 0); // Если включен сетевой режим, отправляем ход по сети
-               return;                      // Завершаем выполнение функции
-           } else if (enemyCount == 1) {    // Если найден ровно один противник — выполняем ход с захватом
-               board->setCell(cellX, cellY, piece); // Перемещаем шашку на целевую клетку
-               board->setCell(selectedX, selectedY, empty); // Очищаем исходную клетку
-               board->setCell(enemyX, enemyY, empty); // Удаляем захваченную шашку противника
-               board->selectCell(cellX, cellY, false); // Снимаем выделение с шашки после хода
-               if (board->canKingCapture(cellX, cellY, piece)) { // Проверяем, может ли дамка продолжить захват
-                   selected = true;       // Если да, оставляем шашку выделенной
-                   selectedX = cellX;       // Обновляем координату X выбранной шашки
-                   selectedY = cellY;       // Обновляем координату Y выбранной шашки
-                   if (networkMode)
-                       networkManager->sendMove(fromX, fromY, cellX, cellY, 1); // Отправляем ход по сети с флагом продолжения захвата
-               } else {
-                   selected = false;      // Если захват завершён, снимаем выделение
-                   currentTurn = (currentTurn == white_checker) ? black_checker : white_checker; // Меняем ход игрока
-                   if (networkMode)
-                       networkManager->sendMove(fromX, fromY, cellX, cellY, 0); // Отправляем ход по сети
-               }
-               return;                      // Выходим из функции
-           }
-        }
-        
-        // Обычный ход для простой шашки (не дамки)
-        if (std::abs(dx) == 1 &&
-            (((piece == white_checker || piece == black_selected) && dy == 1) ||
-             ((piece == black_checker || piece == white_selected) && dy == -1))) {
-             
-            if (board->getCell(cellX, cellY) == empty) { // Если целевая клетка пуста
-                board->setCell(cellX, cellY, piece);       // Перемещаем шашку на целевую клетку
-                board->setCell(selectedX, selectedY, empty); // Очищаем исходную клетку
-                board->selectCell(cellX, cellY, false);      // Снимаем выделение с шашки
-                board->checkForKing(cellX, cellY);           // Проверяем, нужно ли превратить шашку в дамку
-                selected = false;            // Сбрасываем флаг выбора
-                currentTurn = (currentTurn == white_checker) ? black_checker : white_checker; // Меняем ход игрока
-                if (networkMode)
-                    networkManager->sendMove(fromX, fromY, cellX, cellY, 0); // Если игра в сетевом режиме, отправляем ход
-                return;                      // Выходим из функции
-            }
-        }
-        
-        // Захват простой шашкой (прыжок через противника)
-        if (std::abs(dx) == 2 && std::abs(dy) == 2) {
-            int midX = selectedX + dx / 2;  // Вычисляем координату X средней клетки между началом и концом хода
-            int midY = selectedY + dy / 2;  // Вычисляем координату Y средней клетки
-            int middlePiece = board->getCell(midX, midY); // Получаем содержимое средней клетки
-            
-            bool whiteAttack = (piece == white_checker || piece == black_selected); // Определяем, атакует ли белая шашка
-            bool blackAttack = (piece == black_checker || piece == white_selected); // Определяем, атакует ли черная шашка
-            
-            if ((whiteAttack && (middlePiece == black_checker || middlePiece == white_selected ||
-                                 middlePiece == white_king || middlePiece == white_king_selected)) ||
-                (blackAttack && (middlePiece == white_checker || middlePiece == black_selected ||
-                                 middlePiece == black_king || middlePiece == black_king_selected))) {
-                if (board->getCell(cellX, cellY) == empty) { // Если целевая клетка пуста
-                    board->setCell(cellX, cellY, piece);   // Перемещаем шашку на целевую клетку
-                    board->setCell(selectedX, selectedY, empty); // Очищаем исходную клетку
-                    board->setCell(midX, midY, empty);      // Удаляем шашку противника (захват)
-                    board->selectCell(cellX, cellY, false);  // Снимаем выделение с шашки после хода
-                    board->checkForKing(cellX, cellY);       // Проверяем, нужно ли превратить шашку в дамку
-                    if (board->canCapture(cellX, cellY, piece)) { // Проверяем, может ли шашка продолжить захват
-                        selected = true;       // Если да, оставляем шашку выделенной
-                        selectedX = cellX;     // Обновляем координату X выбранной шашки
-                        selectedY = cellY;     // Обновляем координату Y выбранной шашки
-                        if (networkMode)
-                            networkManager->sendMove(fromX, fromY, cellX, cellY, 1); // Отправляем ход с флагом продолжения захвата
-                    } else {
-                        selected = false;      // Если захват завершен, снимаем выделение
-                        currentTurn = (currentTurn == white_checker) ? black_checker : white_checker; // Меняем ход игрока
-                        if (networkMode)
-                            networkManager->sendMove(fromX, fromY, cellX, cellY, 0); // Отправляем ход по сети
-                    }
-                    return;                      // Выходим из функции
-                }
-            }
+        if (canStartMove(cellX, cellY)) { // Выделяем только шашку, которой есть допустимый ход (с учетом обязательного взятия)
+            board->selectCell(cellX, cellY, true); // Выделяем выбранную шашку
+            selected = true;             // Устанавливаем флаг, что шашка выбрана
+            selectedX = cellX;           // Запоминаем индекс X выбранной клетки
+            selectedY = cellY;           // Запоминаем индекс Y выбранной клетки
         }
-        
-        // Если ход не соответствует ни одному из правил — снимаем выделение с выбранной шашки
-        board->selectCell(selectedX, selectedY, false); // Снимаем выделение с исходной клетки
-        selected = false;                // Сбрасываем флаг выбора
+        return;
+    }
+    
+    int fromX = selectedX, fromY = selectedY; // Запоминаем начальные координаты выбранной шашки
+    bool finished;                       // Ход завершен (тихий ход или последний прыжок взятия)
+    if (!applyStep(fromX, fromY, cellX, cellY, finished)) { // Если такого хода или прыжка нет среди допустимых
+        if (jumpsMade == 0) {            // Ход еще не начат — снимаем выделение с выбранной шашки
+            board->selectCell(selectedX, selectedY, false);
+            selected = false;
+        }                                // Во время взятия шашка остается выбранной: взятие нужно закончить
+        return;
+    }
+    
+    if (finished) {
+        selected = false;                // Ход завершен, снимаем выделение
+        currentTurn = (currentTurn == white_checker) ? black_checker : white_checker; // Меняем ход игрока
+        beginTurn();                     // Допустимые ходы соперника
+        commitMove(fromX, fromY, cellX, cellY, 0); // Записываем ход в журнал и, если включен сетевой режим, отправляем его по сети
+    } else {
+        selected = true;                 // Взятие продолжается той же шашкой
+        selectedX = cellX;               // Обновляем координату X выбранной шашки
+        selectedY = cellY;               // Обновляем координату Y выбранной шашки
+        commitMove(fromX, fromY, cellX, cellY, 1); // Записываем ход в журнал и, если включен сетевой режим, отправляем его по сети
     }
 }
 
-void Game::applyNetworkMove(int fromX, int fromY, int toX, int toY, uint8_t continuation) {
-    int piece = board->getCell(fromX, fromY); // Получаем шашку, которая делала ход (по ее исходной позиции)
-    if (std::abs(toX - fromX) >= 2) {     // Если ход перемещает шашку более чем на одну клетку (то есть захват)
-        int dx = (toX - fromX) / std::abs(toX - fromX); // Определяем направление по оси X (1 или -1)
-        int dy = (toY - fromY) / std::abs(toY - fromY); // Определяем направление по оси Y (1 или -1)
-        int enemyX = -1, enemyY = -1;     // Инициализируем координаты противника как -1 (не найден)
-        for (int i = 1; i < std::abs(toX - fromX); i++) { // Проходим по всем клеткам между начальной и целевой позицией
-            int cx = fromX + i * dx;    // Вычисляем текущую клетку по оси X
-            int cy = fromY + i * dy;    // Вычисляем текущую клетку по оси Y
-            int cellVal = board->getCell(cx, cy); // Получаем содержимое текущей клетки
-            if (cellVal != empty && !Board::isFriendly(cellVal, piece)) { // Если клетка занята вражеской шашкой
-                enemyX = cx;          // Запоминаем координату X противника
-                enemyY = cy;          // Запоминаем координату Y противника
-                break;                // Прерываем цикл, так как враг найден
-            }
+//
+// Начало очереди хода: допустимые ходы стороны currentTurn по правилам Rules (обязательное взятие, правило
+// большинства в международных шашках). Если партия восстановлена из журнала посреди взятия, поле уже
+// изменено прыжками, поэтому ходы строятся от текущего поля и ограничиваются продолжением взятия выбранной шашкой
+//
+template <class Geometry>
+void Game<Geometry>::beginTurn() {
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(Position<Geometry>::fromBoard(*board, currentTurn), moves, true); // Все пути взятия: игрок может выбрать любой
+    int continueFrom = selected ? Geometry::squareIndex(selectedX, selectedY) : -1; // Клетка шашки, продолжающей взятие
+    legalMoves.clear();
+    jumpsMade = 0;
+    for (int i = 0; i < count; i++)
+        if (continueFrom < 0 || (moves[i].from == continueFrom && moves[i].isCapture()))
+            legalMoves.push_back(moves[i]);
+    if (legalMoves.empty())
+        std::cout << "Партия окончена: " << (currentTurn == white_checker ? "белым" : "черным") << " некуда ходить" << std::endl;
+}
+
+template <class Geometry>
+bool Game<Geometry>::canStartMove(int x, int y) const {
+    if (!Geometry::playable(x, y)) return false;
+    int square = Geometry::squareIndex(x, y);
+    for (size_t i = 0; i < legalMoves.size(); i++)
+        if (legalMoves[i].from == square) return true;
+    return false;
+}
+
+//
+// Один шаг хода: тихий ход или один прыжок взятия. Шаг должен совпасть с началом хотя бы одного допустимого хода;
+// после шага остаются только ходы с тем же началом. finished — шаг завершает ход (дальше бить нечем)
+//
+template <class Geometry>
+bool Game<Geometry>::applyStep(int fromX, int fromY, int toX, int toY, bool& finished) {
+    if (!Geometry::inside(fromX, fromY) || !Geometry::inside(toX, toY) ||
+        !Geometry::playable(fromX, fromY) || !Geometry::playable(toX, toY))
+        return false;
+    int from = Geometry::squareIndex(fromX, fromY);
+    int to = Geometry::squareIndex(toX, toY);
+    std::vector<Move> matching;          // Допустимые ходы, которые начинаются с этого шага
+    for (size_t i = 0; i < legalMoves.size(); i++) {
+        const Move& move = legalMoves[i];
+        if (move.isCapture()) {
+            if (jumpsMade >= move.captureCount || move.path[jumpsMade] != to) continue;
+            if (jumpsMade == 0 ? move.from != from : move.path[jumpsMade - 1] != from) continue;
+        } else if (jumpsMade > 0 || move.from != from || move.to != to) {
+            continue;
         }
-        if (enemyX != -1 && enemyY != -1)          // Если противник найден
-            board->setCell(enemyX, enemyY, empty); // Удаляем вражескую шашку (захват)
+        matching.push_back(move);
     }
-    board->setCell(toX, toY, piece);      // Перемещаем нашу шашку на целевую клетку
-    board->setCell(fromX, fromY, empty);  // Очищаем исходную клетку (где шашка была до хода)
-    board->selectCell(toX, toY, false);   // Снимаем выделение с новой позиции шашки
-    board->checkForKing(toX, toY);        // Проверяем, должна ли шашка превратиться в дамку после хода
-    if (continuation == 0) {              // Если флаг продолжения захвата равен 0 (захват завершён)
+    if (matching.empty()) return false;
+
+    // Клетки приземления однозначно задают взятые шашки, поэтому у всех подходящих ходов одинаковое продолжение
+    finished = !matching[0].isCapture() || matching[0].captureCount == jumpsMade + 1;
+    board->applyMove(fromX, fromY, toX, toY, finished); // В международных шашках дамкой становятся только в конце хода
+    if (matching[0].isCapture()) jumpsMade++;
+    legalMoves.swap(matching);
+    return true;
+}
+
+template <class Geometry>
+void Game<Geometry>::applyNetworkMove(int fromX, int fromY, int toX, int toY, uint8_t continuation) {
+    PROFILE_SCOPE("Game::applyNetworkMove"); // Замер времени применения хода соперника
+    if (!Geometry::inside(fromX, fromY) || !Geometry::inside(toX, toY) ||
+        !Geometry::playable(fromX, fromY) || !Geometry::playable(toX, toY)) { // Координаты приходят от соперника и не проверены
+        std::cout << "Получен ход за пределами доски, ход отклонен" << std::endl;
+        return;
+    }
+    bool finished;                      // Ход соперника проверяется по тем же правилам, что и собственный
+    if (!applyStep(fromX, fromY, toX, toY, finished) || finished != (continuation == 0)) {
+        std::cout << "Получен недопустимый ход, ход отклонен" << std::endl;
+        return;
+    }
+    if (finished) {                     // Если ход соперника завершен
         currentTurn = localPlayer;      // Устанавливаем, что следующий ход принадлежит локальному игроку
         selected = false;               // Сбрасываем флаг выбора шашки
-    } else {                            // Если ход предусматривает возможность продолжения захвата
+        beginTurn();                    // Допустимые ходы локального игрока
+    } else {                            // Если взятие продолжается
         selected = true;                // Оставляем шашку выделенной
         selectedX = toX;                // Обновляем координату X выбранной шашки
         selectedY = toY;                // Обновляем координату Y выбранной шашки
     }
+    journalMove(fromX, fromY, toX, toY, continuation); // Записываем принятый ход в журнал
+}
+
+template <class Geometry>
+void Game<Geometry>::enableJournal(const std::string& directory) {
+    journalDirectory = directory;       // Журнал откроется в init(), когда будет создано игровое поле
+}
+
+//
+// Открытие журнала: последняя незавершенная партия на доске того же размера продолжается, только если она
+// начата в том же режиме и за ту же сторону (локальная игра или прямое подключение). Партию из режима подбора
+// не продолжаем: сервер подбора назначает нового соперника и сторону, а тот начинает с начальной позиции.
+// Партия, которую нельзя продолжить, закрывается в журнале, и начинается новая
+//
+template <class Geometry>
+bool Game<Geometry>::openJournal() {
+    journal = new WriteAheadLog();      // Создаем объект журнала
+    if (!journal->open(journalDirectory)) return false; // Восстанавливаем партии из снимка и журнала
+
+    std::vector<JournalGame> games = journal->activeGames();
+    const JournalGame* restored = nullptr;
+    for (size_t i = 0; i < games.size(); i++) { // Ищем самую позднюю партию на доске нашего размера
+        if (games[i].boardSize == Geometry::SIZE && (!restored || games[i].gameId > restored->gameId))
+            restored = &games[i];
+    }
+
+    if (restored && (restored->mode != mode || restored->localPlayer != localPlayer || mode == 4)) {
+        std::cout << "Партия " << restored->gameId << " из журнала начата в другом режиме или за другую сторону, "
+                     "начинаем новую" << std::endl;
+        journal->waitDurable(journal->logEnd(restored->gameId)); // Закрываем, чтобы она больше не восстанавливалась
+        restored = nullptr;
+    }
+
+    if (restored) {                     // Восстанавливаем поле, очередь хода и продолжение взятия
+        for (int y = 0; y < Geometry::SIZE; y++)
+            for (int x = 0; x < Geometry::SIZE; x++)
+                board->setCell(x, y, restored->cells[y * Geometry::SIZE + x]);
+        gameId = restored->gameId;
+        currentTurn = restored->currentTurn;
+        selected = restored->selected;
+        selectedX = restored->selectedX;
+        selectedY = restored->selectedY;
+        std::cout << "Продолжаем партию " << gameId << " из журнала" << std::endl;
+    } else {                            // Незавершенных партий нет — начинаем новую
+        gameId = journal->newGameId();
+        journal->waitDurable(journal->logStart(gameId, Geometry::SIZE, mode, localPlayer));
+    }
+    return true;
+}
+
+template <class Geometry>
+void Game<Geometry>::commitMove(int fromX, int fromY, int toX, int toY, uint8_t continuation) {
+    journalMove(fromX, fromY, toX, toY, continuation); // Ход уходит сопернику только после записи на диск
+    if (networkMode)
+        networkManager->sendMove(fromX, fromY, toX, toY, continuation); // Если включен сетевой режим, отправляем ход по сети
+}
+
+//
+// Запись принятого хода в журнал. Ожидание занимает не больше одного fdatasync: ходы всех партий,
+// пришедшие за это время, записываются одной группой
+//
+template <class Geometry>
+void Game<Geometry>::journalMove(int fromX, int fromY, int toX, int toY, uint8_t continuation) {
+    if (!journal) return;               // Журнал не включен
+    uint64_t sequence = journal->logMove(gameId, fromX, fromY, toX, toY, continuation);
+    if (continuation == 0 && legalMoves.empty())
+        sequence = journal->logEnd(gameId); // Соперник не может ходить (нет шашек или все заперты, ходы уже построены beginTurn) — партия окончена и не восстанавливается
+    journal->waitDurable(sequence);
+    if (journal->recordsSinceSnapshot() >= JOURNAL_COMPACT_RECORDS)
+        journal->compact();             // Снимок не дает журналу расти и сокращает время восстановления
 }
 
-void Game::run() {
+template <class Geometry>
+void Game<Geometry>::run() {
     bool running = true;                // Флаг, управляющий основным игровым циклом
     SDL_Event event;                    // Переменная для хранения событий SDL
     
     while (running) {                   // Основной игровой цикл
-        while (SDL_PollEvent(&event)) { // Извлекаем события из очереди
-            if (event.type == SDL_QUIT) // Если получено событие закрытия окна
-                running = false;        // Завершаем игровой цикл, устанавливая флаг в false
-            if (event.type == SDL_MOUSEBUTTONDOWN) // Если произошел клик мыши
-                handleMouseClick(event.button.x, event.button.y); // Обрабатываем клик, передавая координаты
+        PROFILE_SCOPE("Game::run frame"); // Замер времени всего кадра
+        {
+            PROFILE_SCOPE("SDL_PollEvent"); // Замер времени обработки очереди событий
+            while (SDL_PollEvent(&event)) { // Извлекаем события из очереди
+                if (event.type == SDL_QUIT) // Если получено событие закрытия окна
+                    running = false;        // Завершаем игровой цикл, устанавливая флаг в false
+                if (event.type == SDL_MOUSEBUTTONDOWN) // Если произошел клик мыши
+                    handleMouseClick(event.button.x, event.button.y); // Обрабатываем клик, передавая координаты
+                if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F12) // Если нажата клавиша F12
+                    Profiler::dump(traceFile); // Сохраняем трассу последних кадров (например, сразу после заметного подтормаживания)
+            }
         }
         
         // Если игра в сетевом режиме и сейчас ход противника, ждем его хода
@@ -320,15 +344,31 @@ void Game::run() {
         
         SDL_RenderClear(renderer);      // Очищаем окно рендерера, готовясь к новому кадру
         board->draw(renderer);            // Отрисовываем игровое поле и все шашки на рендерере
-        SDL_RenderPresent(renderer);    // Обновляем окно, отображая отрисованный кадр
+        {
+            PROFILE_SCOPE("SDL_RenderPresent"); // Замер времени вывода кадра (включая ожидание вертикальной синхронизации)
+            SDL_RenderPresent(renderer);    // Обновляем окно, отображая отрисованный кадр
+        }
     }
+    if (traceOnExit)                    // Если трасса запрошена флагом --trace, сохраняем ее при выходе
+        Profiler::dump(traceFile);
+}
+
+template <class Geometry>
+void Game<Geometry>::enableTrace(const std::string& path) {
+    traceFile = path;                   // Файл трассы для F12 и для сохранения при выходе
+    traceOnExit = true;
 }
 
-void Game::close() {
+template <class Geometry>
+void Game<Geometry>::close() {
     if (board) {                        // Если объект board существует
         delete board;                   // Освобождаем память, занятую объектом board
         board = nullptr;                // Обнуляем указатель на board
     }
+    if (journal) {                      // Если журнал открыт
+        delete journal;                 // Дописываем оставшиеся записи на диск и закрываем журнал
+        journal = nullptr;              // Обнуляем указатель на journal
+    }
     if (networkManager) {               // Если объект networkManager существует
         networkManager->close();        // Закрываем сетевое соединение и освобождаем связанные ресурсы
         delete networkManager;          // Освобождаем память, занятую объектом networkManager
@@ -350,3 +390,7 @@ void Game::close() {
     IMG_Quit();                        // Завершаем работу с SDL_image и освобождаем связанные ресурсы
     SDL_Quit();                        // Завершаем работу с SDL, освобождая все выделенные ресурсы
 }
+
+// Явное инстанцирование для поддерживаемых вариантов доски
+template class Game<Russian8x8>;
+template class Game<International10x10>;
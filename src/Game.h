@@ -3,10 +3,15 @@
 
 #include "Board.h"                // Подключаем заголовочный файл класса Board, который отвечает за игровое поле
 #include "NetworkManager.h"       // Подключаем заголовочный файл класса NetworkManager для сетевой логики игры
+#include "Rules.h"                // Подключаем правила игры: допустимые ходы проверяются по Rules
+#include "WriteAheadLog.h"        // Подключаем журнал упреждающей записи для восстановления партий после перезапуска
 #include <SDL2/SDL.h>             // Подключаем библиотеку SDL для работы с графикой, окнами и событиями
 #include <string>                 // Подключаем стандартную библиотеку для работы со строками
+#include <vector>                 // Подключаем std::vector для списка допустимых ходов
 
-// Объявление класса Game, который инкапсулирует основную логику игры
+// Объявление шаблона класса Game, который инкапсулирует основную логику игры.
+// Geometry задаёт вариант доски (Russian8x8 или International10x10)
+template <class Geometry>
 class Game {
 public:
     Game();                       // Конструктор класса Game, выполняет базовую инициализацию
@@ -15,6 +20,8 @@ public:
     bool init();                  // Метод инициализации игры (создание окна, загрузка текстур и т.д.)
     void run();                   // Метод запуска игрового цикла
     void close();                 // Метод для корректного завершения игры и освобождения ресурсов
+    void enableJournal(const std::string& directory); // Метод для включения журнала партий в каталоге (вызывается до init)
+    void enableTrace(const std::string& path); // Метод для сохранения трассы профилировщика в файл при выходе
 
 private:
     SDL_Window* window;           // Указатель на окно SDL, где будет отображаться игра
@@ -31,22 +38,38 @@ private:
     SDL_Texture* whiteKing;       // Текстура белой дамки
     SDL_Texture* whiteKingS;      // Текстура белой дамки в выделенном состоянии
     
-    Board* board;                 // Указатель на объект класса Board, который управляет игровым полем
+    Board<Geometry>* board;       // Указатель на объект класса Board, который управляет игровым полем
     NetworkManager* networkManager; // Указатель на объект класса NetworkManager для работы с сетью
+    WriteAheadLog* journal;       // Указатель на журнал партий (nullptr, если журнал не включен)
+    std::string journalDirectory; // Каталог журнала партий
+    uint32_t gameId;              // Идентификатор текущей партии в журнале
+    std::string traceFile;        // Файл трассы профилировщика (сохраняется по F12)
+    bool traceOnExit;             // Сохранять трассу при выходе (флаг --trace)
     
     // Состояние игры
     int currentTurn;              // Переменная, хранящая текущий ход (например, белые или черные)
     int localPlayer;              // Переменная, определяющая, за какую сторону играет локальный игрок
+    int mode;                     // Режим игры, выбранный в меню (1 — сервер, 2 — клиент, 3 — локальная игра, 4 — подбор)
     bool networkMode;             // Флаг, указывающий, запущена ли игра в сетевом режиме
     
     // Выделенная шашка
     bool selected;                // Флаг, указывающий, выбрана ли шашка пользователем
     int selectedX, selectedY;     // Координаты выбранной шашки
     
+    // Допустимые ходы текущей очереди
+    std::vector<Move> legalMoves; // Допустимые ходы, согласующиеся с уже сделанными прыжками (пусто — ходить некуда, партия проиграна)
+    int jumpsMade;                // Сколько прыжков текущего взятия уже сделано
+    
     // Приватные методы для внутренней логики
     SDL_Texture* loadTexture(const char* path); // Метод для загрузки текстуры из файла по указанному пути
     void handleMouseClick(int x, int y);          // Метод для обработки кликов мыши (обработка выбора и перемещения шашки)
     void applyNetworkMove(int fromX, int fromY, int toX, int toY, uint8_t continuation); // Метод для применения хода, полученного по сети
+    bool openJournal();           // Метод для открытия журнала и восстановления незавершенной партии
+    void commitMove(int fromX, int fromY, int toX, int toY, uint8_t continuation); // Метод для фиксации собственного хода: запись в журнал, затем отправка по сети
+    void journalMove(int fromX, int fromY, int toX, int toY, uint8_t continuation); // Метод для записи принятого хода в журнал с ожиданием записи на диск
+    void beginTurn();             // Метод для построения допустимых ходов стороны currentTurn в начале очереди
+    bool canStartMove(int x, int y) const; // Метод для проверки, есть ли у шашки на клетке (x, y) допустимый ход
+    bool applyStep(int fromX, int fromY, int toX, int toY, bool& finished); // Метод для выполнения шага хода, если он допустим; finished — ход завершен
 };
 
 #endif // GAME_H                  // Конец защиты от повторного включения заголовочного файла GAME_H
@@ -0,0 +1,145 @@
+#include "Matchmaker.h"            // Подключаем объявление класса Matchmaker
+#include <algorithm>               // Подключаем std::sort и std::min
+
+namespace {
+
+// Сортировка пула по варианту, затем по рейтингу: соседние игроки одного варианта — ближайшие по силе
+bool byVariantAndRating(const MatchTicket& a, const MatchTicket& b) {
+    return a.variant != b.variant ? a.variant < b.variant : a.rating < b.rating;
+}
+
+} // namespace
+
+Matchmaker::Matchmaker(size_t queueCapacity, const Window& window, const PairingHandler& handler)
+    : queue(queueCapacity), cancellations(queueCapacity), window(window), handler(handler), nextGameId(1),
+      pairings(0), waiting(0), running(false)
+{
+}
+
+Matchmaker::~Matchmaker() {
+    stop();
+}
+
+void Matchmaker::start() {
+    if (running.exchange(true)) return; // Поток уже запущен
+    matcher = std::thread(&Matchmaker::matchLoop, this);
+}
+
+void Matchmaker::stop() {
+    running = false;
+    if (matcher.joinable())
+        matcher.join();
+}
+
+//
+// Постановка в очередь: не берет блокировок и может вызываться из любого числа потоков одновременно
+//
+bool Matchmaker::enqueue(uint32_t playerId, int variant, int rating, void* context) {
+    MatchTicket ticket;
+    ticket.playerId = playerId;
+    ticket.variant = variant;
+    ticket.rating = rating;
+    ticket.context = context;
+    ticket.enqueued = MatchClock::now();
+    return queue.tryPush(ticket);
+}
+
+bool Matchmaker::requeue(const MatchTicket& ticket) {
+    return queue.tryPush(ticket);  // Время постановки сохраняется: окно игрока не сужается, и он остается первым на белые
+}
+
+bool Matchmaker::cancel(uint32_t playerId) {
+    return cancellations.tryPush(playerId);
+}
+
+uint64_t Matchmaker::getPairings() const {
+    return pairings.load(std::memory_order_relaxed);
+}
+
+size_t Matchmaker::getWaiting() const {
+    return waiting.load(std::memory_order_relaxed);
+}
+
+int Matchmaker::windowFor(const MatchTicket& ticket, MatchClock::time_point now) const {
+    double seconds = std::chrono::duration<double>(now - ticket.enqueued).count();
+    double width = window.initial + window.growthPerSecond * seconds;
+    return static_cast<int>(std::min<double>(width, window.maximum));
+}
+
+//
+// Один проход по пулу: соседи по рейтингу соединяются, если разница рейтингов помещается в окно
+// того из них, кто ждет дольше (его окно уже шире)
+//
+bool Matchmaker::matchPool(MatchClock::time_point now) {
+    std::vector<MatchTicket> remaining;
+    remaining.reserve(pool.size());
+    bool matched = false;
+
+    size_t i = 0;
+    while (i < pool.size()) {
+        if (i + 1 < pool.size()) {
+            const MatchTicket& a = pool[i];
+            const MatchTicket& b = pool[i + 1];
+            int allowed = std::max(windowFor(a, now), windowFor(b, now));
+            if (a.variant == b.variant && b.rating - a.rating <= allowed) {
+                Pairing pairing;
+                pairing.gameId = nextGameId++;
+                pairing.white = (a.enqueued <= b.enqueued) ? a : b; // Белыми (первый ход) играет тот, кто ждал дольше
+                pairing.black = (a.enqueued <= b.enqueued) ? b : a;
+                pairing.matched = now;
+                handler(pairing);
+                pairings.fetch_add(1, std::memory_order_relaxed);
+                matched = true;
+                i += 2;
+                continue;
+            }
+        }
+        remaining.push_back(pool[i]);
+        i++;
+    }
+    pool.swap(remaining);
+    return matched;
+}
+
+//
+// Удаление отмененных заявок. Отмены забираются до новых заявок, а cancel вызывается тем же потоком, что и
+// enqueue, поэтому заявка отмененного игрока уже в пуле; если ее нет, пара уже создана и отмена не нужна
+//
+void Matchmaker::removeCancelled(const std::vector<uint32_t>& cancelled) {
+    for (size_t c = 0; c < cancelled.size(); c++) {
+        for (size_t i = 0; i < pool.size(); i++) {
+            if (pool[i].playerId == cancelled[c]) {
+                pool.erase(pool.begin() + i); // Порядок пула сохраняется
+                break;
+            }
+        }
+    }
+}
+
+//
+// Цикл потока подбора: забрать новые заявки, упорядочить пул, соединить пары.
+// Если ничего не произошло, поток засыпает на миллисекунду — за это время окна успевают немного расшириться
+//
+void Matchmaker::matchLoop() {
+    MatchTicket ticket;
+    uint32_t playerId;
+    std::vector<uint32_t> cancelled;
+    while (running.load()) {
+        cancelled.clear();
+        while (cancellations.tryPop(playerId))
+            cancelled.push_back(playerId);
+        bool arrived = false;
+        while (queue.tryPop(ticket)) {
+            pool.push_back(ticket);
+            arrived = true;
+        }
+        if (arrived)
+            std::sort(pool.begin(), pool.end(), byVariantAndRating);
+        if (!cancelled.empty())
+            removeCancelled(cancelled);
+        bool matched = matchPool(MatchClock::now());
+        waiting.store(pool.size(), std::memory_order_relaxed);
+        if (!arrived && !matched)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
@@ -0,0 +1,80 @@
+#ifndef MATCHMAKER_H               // Защита от повторного включения заголовочного файла
+#define MATCHMAKER_H
+
+#include "MpmcQueue.h"             // Подключаем очередь без блокировок для заявок игроков
+#include <atomic>                  // Подключаем атомарные флаги и счетчики
+#include <chrono>                  // Подключаем часы для времени ожидания
+#include <cstdint>                 // Подключаем целочисленные типы фиксированного размера
+#include <functional>              // Подключаем std::function для обработчика найденной пары
+#include <thread>                  // Подключаем поток подбора соперников
+#include <vector>                  // Подключаем std::vector
+
+typedef std::chrono::steady_clock MatchClock;
+
+// Заявка игрока на подбор соперника
+struct MatchTicket {
+    uint32_t playerId;             // Идентификатор игрока
+    int variant;                   // Вариант игры (размер доски): соперник подбирается только с тем же вариантом
+    int rating;                    // Рейтинг игрока
+    void* context;                 // Данные вызывающей стороны (например, сокет игрока)
+    MatchClock::time_point enqueued; // Время постановки в очередь
+};
+
+// Найденная пара: новая партия и стороны игроков
+struct Pairing {
+    uint32_t gameId;               // Идентификатор новой партии
+    MatchTicket white;             // Игрок, получивший white_checker (ходит первым)
+    MatchTicket black;             // Игрок, получивший black_checker
+    MatchClock::time_point matched; // Время создания пары
+};
+
+//
+// Подбор соперников. Производители (поток приема соединений) ставят заявки в очередь без блокировок (enqueue),
+// а единственный поток подбора забирает их в свой пул, упорядоченный по варианту и рейтингу, и соединяет соседей
+// с одинаковым вариантом игры.
+// Допустимая разница рейтингов растет со временем ожидания, поэтому даже игрок с редким рейтингом
+// рано или поздно получает соперника. Белыми играет тот, кто ждал дольше.
+//
+class Matchmaker {
+public:
+    typedef std::function<void(const Pairing&)> PairingHandler;
+
+    // Параметры окна рейтинга: начальная ширина, рост в секунду ожидания и предел
+    struct Window {
+        int initial;               // Допустимая разница рейтингов сразу после постановки в очередь
+        int growthPerSecond;       // Расширение окна за секунду ожидания
+        int maximum;               // Максимальная ширина окна
+    };
+
+    Matchmaker(size_t queueCapacity, const Window& window, const PairingHandler& handler);
+    ~Matchmaker();                 // Деструктор: останавливает поток подбора
+
+    void start();                  // Запуск потока подбора
+    void stop();                   // Остановка потока подбора (заявки в пуле остаются без пары)
+
+    bool enqueue(uint32_t playerId, int variant, int rating, void* context); // Постановка в очередь; false — очередь заполнена
+    bool requeue(const MatchTicket& ticket); // Возврат заявки в очередь с прежним временем ожидания (соперник отключился)
+    bool cancel(uint32_t playerId); // Удаление заявки из пула (игрок отключился); вызывается тем же потоком, что enqueue
+
+    uint64_t getPairings() const;  // Количество созданных пар
+    size_t getWaiting() const;     // Количество игроков в пуле ожидания
+
+private:
+    void matchLoop();              // Цикл потока подбора
+    bool matchPool(MatchClock::time_point now); // Один проход по пулу; true — создана хотя бы одна пара
+    void removeCancelled(const std::vector<uint32_t>& cancelled); // Удаление отмененных заявок из пула
+    int windowFor(const MatchTicket& ticket, MatchClock::time_point now) const; // Текущая ширина окна игрока
+
+    MpmcQueue<MatchTicket> queue;  // Новые заявки от потоков приема
+    MpmcQueue<uint32_t> cancellations; // Игроки, отключившиеся до подбора пары
+    std::vector<MatchTicket> pool; // Пул ожидания (только поток подбора)
+    Window window;                 // Параметры окна рейтинга
+    PairingHandler handler;        // Обработчик найденной пары (вызывается в потоке подбора)
+    uint32_t nextGameId;           // Идентификатор следующей партии
+    std::atomic<uint64_t> pairings; // Количество созданных пар
+    std::atomic<size_t> waiting;   // Размер пула ожидания
+    std::atomic<bool> running;     // Поток подбора работает
+    std::thread matcher;           // Поток подбора
+};
+
+#endif // MATCHMAKER_H
@@ -0,0 +1,89 @@
+#ifndef MPMCQUEUE_H                // Защита от повторного включения заголовочного файла
+#define MPMCQUEUE_H
+
+#include <atomic>                  // Подключаем атомарные переменные
+#include <cstddef>                 // Подключаем size_t
+#include <vector>                  // Подключаем std::vector для кольцевого буфера
+
+//
+// Ограниченная очередь без блокировок для многих производителей и многих потребителей (схема Вьюкова).
+// Каждая ячейка хранит счетчик последовательности: производитель и потребитель захватывают позицию
+// одним compare_exchange и больше не мешают друг другу, поэтому поток приема соединений не ждет
+// поток подбора соперников. Емкость округляется вверх до степени двойки.
+//
+template <class T>
+class MpmcQueue {
+public:
+    explicit MpmcQueue(size_t capacity)
+        : mask(roundUp(capacity) - 1), cells(roundUp(capacity)), head(0), tail(0)
+    {
+        for (size_t i = 0; i < cells.size(); i++)
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Добавление элемента; false — очередь заполнена
+    bool tryPush(const T& value) {
+        size_t position = tail.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+            if (difference == 0) { // Ячейка свободна — пытаемся занять позицию
+                if (tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(position + 1, std::memory_order_release); // Публикуем элемент для потребителей
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;      // Ячейка еще не освобождена потребителем — очередь заполнена
+            } else {
+                position = tail.load(std::memory_order_relaxed); // Позицию занял другой производитель
+            }
+        }
+    }
+
+    // Извлечение элемента; false — очередь пуста
+    bool tryPop(T& value) {
+        size_t position = head.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[position & mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+            if (difference == 0) { // Элемент опубликован — пытаемся забрать позицию
+                if (head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    value = cell.value;
+                    cell.sequence.store(position + mask + 1, std::memory_order_release); // Освобождаем ячейку для следующего круга
+                    return true;
+                }
+            } else if (difference < 0) {
+                return false;      // Элемент еще не записан — очередь пуста
+            } else {
+                position = head.load(std::memory_order_relaxed); // Позицию забрал другой потребитель
+            }
+        }
+    }
+
+    size_t capacity() const { return mask + 1; }
+
+private:
+    static const size_t CACHE_LINE = 64; // Размер строки кэша: счетчики на разных строках не мешают друг другу
+
+    struct Cell {
+        std::atomic<size_t> sequence; // Номер круга, на котором ячейка готова к записи или чтению
+        T value;                      // Элемент очереди
+    };
+
+    static size_t roundUp(size_t value) {
+        size_t result = 2;
+        while (result < value) result <<= 1;
+        return result;
+    }
+
+    const size_t mask;             // Маска индекса в кольцевом буфере
+    std::vector<Cell> cells;       // Кольцевой буфер
+    alignas(CACHE_LINE) std::atomic<size_t> head; // Позиция чтения (потребители)
+    alignas(CACHE_LINE) std::atomic<size_t> tail; // Позиция записи (производители)
+    char padding[CACHE_LINE - sizeof(std::atomic<size_t>)]; // Отделяем tail от соседних данных
+};
+
+#endif // MPMCQUEUE_H
@@ -1,6 +1,7 @@
 #include "NetworkManager.h"           // Подключаем заголовочный файл класса NetworkManager
 #include <iostream>                   // Подключаем стандартную библиотеку ввода-вывода для вывода сообщений об ошибках и статуса
 #include <SDL2/SDL.h>                 // Подключаем SDL для работы с базовыми функциями, необходимыми для SDL_net
+#include "Profiler.h"                 // Подключаем замеры времени горячих путей (PROFILE_SCOPE)
 
 //
 // Конструктор класса NetworkManager
@@ -25,7 +26,7 @@ NetworkManager::~NetworkManager() {
 //
 // Метод для инициализации сервера
 //
-bool NetworkManager::initServer() {
+bool NetworkManager::initServer(int boardSize) {
     networkMode = true;              // Включаем сетевой режим
     isServer = true;                 // Устанавливаем, что данный экземпляр является сервером
     if (SDLNet_Init() < 0) {          // Инициализируем библиотеку SDL_net; если инициализация не удалась
@@ -49,13 +50,21 @@ bool NetworkManager::initServer() {
     std::cout << "Клиент подключен!" << std::endl; // Выводим сообщение о том, что клиент успешно подключился
     socketSet = SDLNet_AllocSocketSet(1); // Выделяем набор сокетов для одного сокета (tcpSocket)
     SDLNet_TCP_AddSocket(socketSet, tcpSocket); // Добавляем TCP-сокет в набор для отслеживания событий
-    return true;                     // Возвращаем true, сигнализируя об успешной инициализации сервера
+    return exchangeBoardSize(boardSize); // Сверяем размер доски с клиентом
 }
 
 //
 // Метод для инициализации клиента
 //
-bool NetworkManager::initClient(const std::string& serverIP) {
+bool NetworkManager::initClient(const std::string& serverIP, int boardSize) {
+    if (!connectToServer(serverIP)) return false; // Подключаемся к серверу
+    return exchangeBoardSize(boardSize); // Сверяем размер доски с сервером
+}
+
+//
+// Метод для подключения к серверу
+//
+bool NetworkManager::connectToServer(const std::string& serverIP) {
     networkMode = true;              // Включаем сетевой режим
     isServer = false;                // Устанавливаем, что данный экземпляр является клиентом
     if (SDLNet_Init() < 0) {          // Инициализируем библиотеку SDL_net; если инициализация не удалась
@@ -75,7 +84,53 @@ bool NetworkManager::initClient(const std::string& serverIP) {
     std::cout << "Подключение к серверу успешно!" << std::endl; // Выводим сообщение об успешном подключении к серверу
     socketSet = SDLNet_AllocSocketSet(1); // Выделяем набор сокетов для одного сокета (tcpSocket)
     SDLNet_TCP_AddSocket(socketSet, tcpSocket); // Добавляем TCP-сокет в набор для отслеживания событий
-    return true;                     // Возвращаем true, сигнализируя об успешной инициализации клиента
+    return true;                     // Возвращаем true, сигнализируя об успешном подключении
+}
+
+//
+// Метод для обмена размером доски: каждая сторона отправляет свой размер и читает размер соперника.
+// Без этой проверки клиенты с досками 8x8 и 10x10 приняли бы координаты ходов друг друга
+//
+bool NetworkManager::exchangeBoardSize(int boardSize) {
+    uint8_t own = static_cast<uint8_t>(boardSize); // Размер нашей доски
+    uint8_t other = 0;               // Размер доски соперника
+    if (SDLNet_TCP_Send(tcpSocket, &own, 1) < 1 || SDLNet_TCP_Recv(tcpSocket, &other, 1) != 1) {
+        std::cout << "Соединение закрыто до начала игры" << std::endl;
+        return false;
+    }
+    if (other != own) {              // Соперник играет на доске другого размера
+        std::cout << "Соперник играет на доске " << static_cast<int>(other) << "x" << static_cast<int>(other)
+                  << ", а вы на " << boardSize << "x" << boardSize << std::endl;
+        return false;
+    }
+    return true;
+}
+
+//
+// Метод для подбора соперника через сервер подбора
+//
+bool NetworkManager::initMatchmaking(const std::string& serverIP, int boardSize, int rating, int& side) {
+    if (!connectToServer(serverIP)) return false; // Подключаемся к серверу подбора так же, как к обычному серверу (размер доски проверяет сервер)
+    if (rating < 0) rating = 0;      // Рейтинг передается двумя байтами без знака
+    if (rating > 0xFFFF) rating = 0xFFFF;
+    uint8_t request[MATCH_REQUEST_SIZE]; // Запрос: признак подбора, размер доски и рейтинг (2 байта, старший первым)
+    request[0] = MATCH_REQUEST;
+    request[1] = static_cast<uint8_t>(boardSize); // Сервер соединяет только игроков с одинаковой доской
+    request[2] = static_cast<uint8_t>((rating >> 8) & 0xFF);
+    request[3] = static_cast<uint8_t>(rating & 0xFF);
+    if (SDLNet_TCP_Send(tcpSocket, request, MATCH_REQUEST_SIZE) < MATCH_REQUEST_SIZE) { // Отправляем запрос; если отправка не удалась
+        std::cout << "Не удалось отправить запрос на подбор: " << SDLNet_GetError() << std::endl;
+        return false;
+    }
+    std::cout << "Ожидание соперника..." << std::endl; // Сервер ответит, когда найдет соперника с близким рейтингом
+    uint8_t assigned = 0;            // Сторона, назначенная сервером
+    if (SDLNet_TCP_Recv(tcpSocket, &assigned, 1) != 1) { // Ждем ответа сервера (блокирующее чтение)
+        std::cout << "Сервер подбора закрыл соединение" << std::endl;
+        return false;
+    }
+    side = assigned;                 // Сохраняем назначенную сторону (1 — white_checker, 2 — black_checker)
+    std::cout << (side == 1 ? "Соперник найден, вы играете белыми" : "Соперник найден, вы играете черными") << std::endl;
+    return true;                     // Дальше ходы идут через сервер подбора так же, как при прямом подключении
 }
 
 //
@@ -96,6 +151,7 @@ void NetworkManager::sendMove(int fromX, int fromY, int toX, int toY, uint8_t co
 // Метод для получения хода по сети
 //
 bool NetworkManager::receiveMove(int& fromX, int& fromY, int& toX, int& toY, uint8_t& continuation) {
+    PROFILE_SCOPE("NetworkManager::receiveMove"); // Замер времени опроса сокета и чтения пакета
     if (!networkMode) return false;  // Если сетевой режим не включен, возвращаем false, так как ход не может быть получен
     int numReady = SDLNet_CheckSockets(socketSet, 0); // Проверяем набор сокетов на наличие готовых к чтению данных, таймаут 0 мс
     if (numReady > 0) {              // Если есть сокеты с готовыми данными
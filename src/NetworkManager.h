@@ -5,14 +5,24 @@
 #include <cstdint>                 // Подключаем заголовочный файл для фиксированных целочисленных типов (например, uint8_t)
 #include <string>                  // Подключаем библиотеку для работы со строками (std::string)
 
+// Запрос на подбор соперника, который клиент отправляет серверу подбора (checkers-lobby):
+// признак MATCH_REQUEST, размер доски (вариант игры) и рейтинг (2 байта, старший первым)
+const uint8_t MATCH_REQUEST = 'M';
+const int MATCH_REQUEST_SIZE = 4;
+
 // Объявление класса NetworkManager, отвечающего за сетевое взаимодействие (инициализация сервера/клиента, отправка и получение данных)
 class NetworkManager {
 public:
     NetworkManager();             // Конструктор класса, инициализирует объект NetworkManager
     ~NetworkManager();            // Деструктор класса, освобождает ресурсы, связанные с сетевым соединением
 
-    bool initServer();            // Метод для инициализации сервера; возвращает true, если сервер успешно инициализирован
-    bool initClient(const std::string& serverIP); // Метод для инициализации клиента с указанным IP сервера; возвращает true при успешном подключении
+    // Методы для инициализации сервера и клиента; после подключения стороны обмениваются размером доски
+    // и отказываются от игры, если он не совпадает; возвращают true при успешном подключении
+    bool initServer(int boardSize);
+    bool initClient(const std::string& serverIP, int boardSize);
+    // Метод для подключения к серверу подбора: отправляет размер доски и рейтинг и ждет соперника с той же доской;
+    // side получает сторону, назначенную сервером (white_checker или black_checker)
+    bool initMatchmaking(const std::string& serverIP, int boardSize, int rating, int& side);
 
     // Метод для отправки данных хода по сети:
     // fromX, fromY - начальные координаты, toX, toY - конечные координаты, continuation - флаг продолжения хода (например, для множественного захвата)
@@ -28,6 +38,9 @@ public:
     bool isNetworkMode() const { return networkMode; }
 
 private:
+    bool connectToServer(const std::string& serverIP); // Метод для подключения к серверу (игры или подбора)
+    bool exchangeBoardSize(int boardSize); // Метод для обмена размером доски с соперником; false — размеры не совпадают
+
     bool networkMode;             // Флаг, указывающий, запущен ли сетевой режим (true, если да)
     bool isServer;                // Флаг, указывающий, является ли этот экземпляр сервером (true) или клиентом (false)
     TCPsocket tcpSocket;          // TCP-сокет, используемый для соединения (как для сервера, так и для клиента)
@@ -0,0 +1,154 @@
+#include "Notation.h"              // Подключаем объявление класса Notation
+#include <cctype>                  // Подключаем std::isdigit
+#include <cstdlib>                 // Подключаем std::atoi
+#include <sstream>                 // Подключаем строковые потоки для сборки FEN
+#include <vector>                  // Подключаем std::vector для списка клеток в записи хода
+
+//
+// Запись хода в нотации PDN
+//
+template <class Geometry>
+std::string Notation<Geometry>::moveToString(const Move& move) {
+    std::ostringstream out;
+    out << squareNumber(move.from);
+    if (!move.isCapture()) {
+        out << '-' << squareNumber(move.to);             // Тихий ход: "откуда-куда"
+    } else {
+        for (int i = 0; i < move.captureCount; i++)
+            out << 'x' << squareNumber(move.path[i]);    // Взятие: все клетки приземления, чтобы запись была однозначной
+    }
+    return out.str();
+}
+
+//
+// Разбор записи хода: первая клетка — откуда, последняя — куда, промежуточные — клетки приземления при взятии
+//
+template <class Geometry>
+bool Notation<Geometry>::parseMove(const PositionType& position, const std::string& text, Move& move) {
+    std::vector<int> squares;      // Номера клеток из записи
+    bool capture = false;          // В записи использован знак взятия 'x'
+    size_t i = 0;
+    while (i < text.size()) {
+        if (std::isdigit(static_cast<unsigned char>(text[i]))) {
+            size_t start = i;
+            while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) i++;
+            int number = std::atoi(text.substr(start, i - start).c_str());
+            if (!validNumber(number)) return false;
+            squares.push_back(squareIndex(number));
+        } else if (text[i] == 'x' || text[i] == 'X' || text[i] == ':') {
+            capture = true;
+            i++;
+        } else if (text[i] == '-') {
+            i++;
+        } else if (text[i] == '!' || text[i] == '?' || text[i] == '*' || text[i] == '+') {
+            i++;                   // Комментарии к ходу ("!", "?") пропускаем
+        } else {
+            return false;          // Посторонний символ — это не запись хода
+        }
+    }
+    if (squares.size() < 2) return false;
+
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves, true); // Все пути: запись может идти по любому из них
+    for (int m = 0; m < count; m++) {
+        const Move& candidate = moves[m];
+        if (candidate.from != squares.front() || candidate.to != squares.back()) continue;
+        if (capture && !candidate.isCapture()) continue;
+        bool matches = true;       // Промежуточные клетки записи должны совпасть с клетками приземления
+        if (squares.size() > 2) {
+            if (static_cast<int>(squares.size()) - 1 != candidate.captureCount) continue;
+            for (size_t k = 1; k + 1 < squares.size(); k++) {
+                if (candidate.path[k - 1] != squares[k]) {
+                    matches = false;
+                    break;
+                }
+            }
+        }
+        if (matches) {
+            move = candidate;      // При неоднозначной краткой записи берем первый подходящий ход
+            return true;
+        }
+    }
+    return false;
+}
+
+//
+// Разбор FEN: "<сторона>:W<клетки>:B<клетки>", клетки через запятую, диапазоны через дефис, дамки с префиксом K
+//
+template <class Geometry>
+bool Notation<Geometry>::parseFen(const std::string& fen, PositionType& position) {
+    PositionType parsed;
+    std::string text;
+    for (size_t i = 0; i < fen.size(); i++) {
+        if (fen[i] != ' ' && fen[i] != '"' && fen[i] != '.') text += fen[i]; // Пробелы, кавычки и точку в конце пропускаем
+    }
+    if (text.empty()) return false;
+    if (text[0] == 'W' || text[0] == 'w') parsed.sideToMove = white_checker;
+    else if (text[0] == 'B' || text[0] == 'b') parsed.sideToMove = black_checker;
+    else return false;
+
+    size_t pos = 1;
+    while (pos < text.size()) {
+        if (text[pos] != ':') return false;
+        pos++;
+        if (pos >= text.size()) break;
+        bool white;
+        if (text[pos] == 'W' || text[pos] == 'w') white = true;
+        else if (text[pos] == 'B' || text[pos] == 'b') white = false;
+        else return false;
+        pos++;
+        size_t end = text.find(':', pos);
+        if (end == std::string::npos) end = text.size();
+        std::string list = text.substr(pos, end - pos);   // Список клеток одной стороны
+        pos = end;
+
+        std::istringstream items(list);
+        std::string item;
+        while (std::getline(items, item, ',')) {
+            if (item.empty()) continue;
+            bool king = false;
+            if (item[0] == 'K' || item[0] == 'k') {
+                king = true;
+                item = item.substr(1);
+            }
+            size_t dash = item.find('-');
+            int first = std::atoi(item.substr(0, dash).c_str());
+            int last = (dash == std::string::npos) ? first : std::atoi(item.substr(dash + 1).c_str());
+            if (!validNumber(first) || !validNumber(last) || first > last) return false;
+            for (int number = first; number <= last; number++) {
+                int8_t piece = white ? (king ? piece_white_king : piece_white_man)
+                                     : (king ? piece_black_king : piece_black_man);
+                parsed.squares[squareIndex(number)] = piece;
+            }
+        }
+    }
+    position = parsed;
+    return true;
+}
+
+//
+// Запись позиции в FEN
+//
+template <class Geometry>
+std::string Notation<Geometry>::toFen(const PositionType& position) {
+    std::ostringstream out;
+    out << (position.sideToMove == white_checker ? 'W' : 'B');
+    for (int side = 0; side < 2; side++) {
+        out << ':' << (side == 0 ? 'W' : 'B');
+        bool first = true;
+        for (int number = 1; number <= Geometry::SQUARES; number++) {
+            int piece = position.squares[squareIndex(number)];
+            bool own = (side == 0) ? Rules<Geometry>::isWhite(piece) : Rules<Geometry>::isBlack(piece);
+            if (!own) continue;
+            if (!first) out << ',';
+            if (Rules<Geometry>::isKing(piece)) out << 'K';
+            out << number;
+            first = false;
+        }
+    }
+    return out.str();
+}
+
+// Явное инстанцирование для поддерживаемых вариантов доски
+template class Notation<Russian8x8>;
+template class Notation<International10x10>;
@@ -0,0 +1,33 @@
+#ifndef NOTATION_H                 // Защита от повторного включения заголовочного файла
+#define NOTATION_H
+
+#include "Rules.h"                 // Подключаем правила для сопоставления записи хода с допустимыми ходами
+#include <string>                  // Подключаем std::string
+
+//
+// Стандартная числовая нотация шашек (PDN): игровые клетки нумеруются от 1 со стороны черных,
+// белые стоят на клетках с наибольшими номерами и ходят первыми.
+// На нашей доске белые стоят сверху, поэтому номер клетки получается поворотом доски на 180 градусов:
+// номер = SQUARES - индекс клетки.
+//
+template <class Geometry>
+class Notation {
+public:
+    typedef Position<Geometry> PositionType;  // Тип позиции для данной геометрии
+
+    static int squareNumber(int square) { return Geometry::SQUARES - square; }  // Индекс клетки -> номер в нотации
+    static int squareIndex(int number) { return Geometry::SQUARES - number; }   // Номер в нотации -> индекс клетки
+    static bool validNumber(int number) { return number >= 1 && number <= Geometry::SQUARES; }
+
+    // Запись хода в PDN: "32-28" для тихого хода, "28x19x10" (все клетки приземления) для взятия
+    static std::string moveToString(const Move& move);
+    // Разбор записи хода и поиск соответствующего допустимого хода; возвращает false, если такого хода нет
+    static bool parseMove(const PositionType& position, const std::string& text, Move& move);
+
+    // Разбор позиции в формате FEN из PDN ("W:W31-50:B1-20", дамки помечаются буквой K)
+    static bool parseFen(const std::string& fen, PositionType& position);
+    // Запись позиции в формате FEN
+    static std::string toFen(const PositionType& position);
+};
+
+#endif // NOTATION_H
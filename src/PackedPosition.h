@@ -0,0 +1,52 @@
+#ifndef PACKEDPOSITION_H           // Защита от повторного включения заголовочного файла
+#define PACKEDPOSITION_H
+
+#include "Position.h"              // Подключаем компактную позицию движка
+
+//
+// Упакованная позиция для обучения: три битовые маски игровых клеток, сторона, которая ходит, и результат партии.
+// Для доски 8x8 это 16 байт, поэтому в памяти помещаются десятки миллионов позиций.
+//
+template <class Geometry>
+struct PackedPosition {
+    typedef typename Geometry::Mask Mask;  // Битовая маска игровых клеток (32 или 64 бита)
+
+    Mask white;                    // Клетки с белыми фигурами
+    Mask black;                    // Клетки с черными фигурами
+    Mask kings;                    // Клетки с дамками (любого цвета)
+    uint8_t blackToMove;           // 1, если ходят черные
+    uint8_t result;                // Результат партии для белых: 0 — поражение, 1 — ничья, 2 — победа
+
+    // Упаковка позиции; whiteScore — результат партии для белых (0, 0.5 или 1)
+    static PackedPosition pack(const Position<Geometry>& position, double whiteScore) {
+        PackedPosition packed;
+        packed.white = packed.black = packed.kings = 0;
+        for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+            Mask bit = static_cast<Mask>(Mask(1) << sq);
+            int piece = position.squares[sq];
+            if (piece == piece_white_man || piece == piece_white_king) packed.white |= bit;
+            if (piece == piece_black_man || piece == piece_black_king) packed.black |= bit;
+            if (piece == piece_white_king || piece == piece_black_king) packed.kings |= bit;
+        }
+        packed.blackToMove = (position.sideToMove == black_checker) ? 1 : 0;
+        packed.result = static_cast<uint8_t>(whiteScore * 2.0 + 0.5);
+        return packed;
+    }
+
+    // Распаковка в позицию движка
+    Position<Geometry> unpack() const {
+        Position<Geometry> position;
+        for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+            Mask bit = static_cast<Mask>(Mask(1) << sq);
+            bool king = (kings & bit) != 0;
+            if (white & bit) position.squares[sq] = king ? piece_white_king : piece_white_man;
+            else if (black & bit) position.squares[sq] = king ? piece_black_king : piece_black_man;
+        }
+        position.sideToMove = blackToMove ? black_checker : white_checker;
+        return position;
+    }
+
+    double whiteScore() const { return result * 0.5; } // Результат партии для белых (0, 0.5 или 1)
+};
+
+#endif // PACKEDPOSITION_H
@@ -0,0 +1,123 @@
+#include "PdnReader.h"             // Подключаем объявление класса PdnReader
+#include <cctype>                  // Подключаем std::isspace и std::isdigit
+
+namespace {
+
+// Является ли лексема результатом партии (завершает запись ходов)
+bool isResultToken(const std::string& token) {
+    return token == "2-0" || token == "0-2" || token == "1-1" || token == "0-0" ||
+           token == "1-0" || token == "0-1" || token == "1/2-1/2" || token == "*";
+}
+
+} // namespace
+
+double PdnGame::whiteScore() const {
+    if (result == "2-0" || result == "1-0") return 1.0;        // Победа белых
+    if (result == "0-2" || result == "0-1") return 0.0;        // Победа черных
+    if (result == "1-1" || result == "1/2-1/2") return 0.5;    // Ничья
+    return -1.0;                                               // Результат неизвестен
+}
+
+PdnReader::PdnReader(std::istream& input)
+    : input(input), pendingTag(false)
+{
+}
+
+//
+// Чтение тега вида [Name "Value"] (символ '[' уже прочитан)
+//
+bool PdnReader::readTag(std::string& name, std::string& value) {
+    name.clear();
+    value.clear();
+    char c;
+    while (input.get(c) && std::isspace(static_cast<unsigned char>(c))) {}
+    while (input && c != ']' && c != '"' && !std::isspace(static_cast<unsigned char>(c))) {
+        name += c;
+        input.get(c);
+    }
+    while (input && c != '"' && c != ']') input.get(c);        // Ищем начало значения
+    if (input && c == '"') {
+        while (input.get(c) && c != '"') {
+            if (c == '\\' && input.get(c)) value += c;         // Экранированный символ
+            else value += c;
+        }
+        while (input.get(c) && c != ']') {}
+    }
+    return static_cast<bool>(input);
+}
+
+void PdnReader::skipUntil(char close) {
+    char open = (close == ')') ? '(' : '{';
+    int depth = 1;
+    char c;
+    while (depth > 0 && input.get(c)) {
+        if (c == open && close == ')') depth++;                // Варианты могут быть вложенными
+        else if (c == close) depth--;
+        else if (c == '{' && close == ')') skipUntil('}');     // Комментарий внутри варианта
+    }
+}
+
+//
+// Чтение следующей партии
+//
+bool PdnReader::next(PdnGame& game) {
+    game.fen.clear();
+    game.result = "*";
+    game.moves.clear();
+    bool started = false;          // Встретили хотя бы один тег или ход этой партии
+    bool inMoves = false;          // Началась запись ходов
+    std::string token;
+    char c;
+
+    while (true) {
+        if (pendingTag) {
+            c = '[';
+            pendingTag = false;
+        } else if (!input.get(c)) {
+            break;
+        }
+
+        if (c == '[') {
+            if (inMoves) {         // Тег после ходов — это начало следующей партии без явного результата
+                pendingTag = true;
+                return true;
+            }
+            std::string name, value;
+            readTag(name, value);
+            if (name == "FEN") game.fen = value;
+            else if (name == "Result") game.result = value;
+            started = true;
+        } else if (c == '{') {
+            skipUntil('}');
+        } else if (c == '(') {
+            skipUntil(')');
+        } else if (c == ';') {     // Комментарий до конца строки
+            while (input.get(c) && c != '\n') {}
+        } else if (std::isspace(static_cast<unsigned char>(c))) {
+            continue;
+        } else {
+            token.clear();
+            token += c;
+            while (input.get(c)) {
+                if (std::isspace(static_cast<unsigned char>(c)) || c == '{' || c == '(' || c == '[' || c == ';') {
+                    input.unget();
+                    break;
+                }
+                token += c;
+            }
+            if (token[0] == '$') continue;                     // Числовая оценка хода (NAG)
+            size_t dot = token.find_last_of('.');
+            if (dot != std::string::npos) token = token.substr(dot + 1); // Номер хода ("12." или "12...32-28")
+            if (token.empty()) continue;
+            started = true;
+            inMoves = true;
+            if (isResultToken(token)) {
+                if (token != "*" || game.result.empty()) game.result = token;
+                return true;
+            }
+            if (std::isdigit(static_cast<unsigned char>(token[0])))
+                game.moves.push_back(token);
+        }
+    }
+    return started;
+}
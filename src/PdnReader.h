@@ -0,0 +1,36 @@
+#ifndef PDNREADER_H                // Защита от повторного включения заголовочного файла
+#define PDNREADER_H
+
+#include <istream>                 // Подключаем потоки ввода
+#include <string>                  // Подключаем std::string
+#include <vector>                  // Подключаем std::vector для списка ходов
+
+// Партия из архива PDN: начальная позиция, ходы в текстовой записи и результат
+struct PdnGame {
+    std::string fen;               // Начальная позиция из тега FEN (пустая строка — стандартная расстановка)
+    std::string result;            // Результат партии: "2-0", "1-1", "0-2" (или "1-0", "1/2-1/2", "0-1"), "*" — неизвестен
+    std::vector<std::string> moves; // Ходы основной линии в нотации PDN
+
+    // Результат с точки зрения белых: 1 — победа, 0.5 — ничья, 0 — поражение, -1 — неизвестен
+    double whiteScore() const;
+};
+
+//
+// Потоковое чтение архива партий в формате PDN: партии читаются по одной, поэтому архив может быть
+// сколь угодно большим. Комментарии, варианты, номера ходов и оценки ходов пропускаются.
+//
+class PdnReader {
+public:
+    explicit PdnReader(std::istream& input); // Конструктор: поток, из которого читаются партии
+
+    bool next(PdnGame& game);      // Чтение следующей партии; возвращает false, если партий больше нет
+
+private:
+    std::istream& input;           // Поток с архивом партий
+    bool pendingTag;               // Прочитан символ '[' следующей партии
+
+    bool readTag(std::string& name, std::string& value); // Чтение тега после символа '['
+    void skipUntil(char close);    // Пропуск комментария или варианта до закрывающего символа (с учетом вложенности)
+};
+
+#endif // PDNREADER_H
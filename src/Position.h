@@ -0,0 +1,96 @@
+#ifndef POSITION_H                 // Защита от повторного включения заголовочного файла
+#define POSITION_H
+
+#include "Board.h"                 // Подключаем Board для преобразования позиции с игрового поля
+#include <cstdint>                 // Подключаем целочисленные типы фиксированного размера
+#include <cstring>                 // Подключаем std::memset для очистки массива клеток
+
+// Коды фигур в компактной позиции движка (в отличие от CellState без состояний выделения)
+enum PieceCode {
+    piece_none = 0,                // Пустая клетка
+    piece_white_man = 1,           // Белая простая шашка
+    piece_white_king = 2,          // Белая дамка
+    piece_black_man = 3,           // Черная простая шашка
+    piece_black_king = 4           // Черная дамка
+};
+
+const int PIECE_CODES = 5;         // Количество кодов фигур (включая пустую клетку)
+
+//
+// Компактная позиция для движка: по одному байту на игровую клетку и сторона, которая делает ход.
+// Массив дополнен нулями до кратного 16 размера, чтобы SIMD-ядра читали клетки целыми векторами.
+//
+template <class Geometry>
+struct Position {
+    static const int PADDED_SQUARES = (Geometry::SQUARES + 15) & ~15; // Размер массива клеток с выравниванием
+
+    int8_t squares[PADDED_SQUARES]; // Коды фигур (PieceCode) по индексам игровых клеток
+    int sideToMove;                // Сторона, которая ходит: white_checker или black_checker
+
+    Position() : sideToMove(white_checker) {
+        std::memset(squares, 0, sizeof(squares)); // Все клетки (и дополнение) пустые
+    }
+
+    // Преобразование состояния клетки игрового поля в код фигуры
+    static int8_t pieceCode(int cell) {
+        switch (cell) {
+            case white_checker: case black_selected: return piece_white_man;                    // Белая шашка (в том числе выделенная)
+            case black_king: case black_king_selected: return piece_white_king;                 // Белая дамка (константа black_king, см. Board::checkForKing)
+            case black_checker: case white_selected: return piece_black_man;                    // Черная шашка (в том числе выделенная)
+            case white_king: case white_king_selected: return piece_black_king;                 // Черная дамка (константа white_king)
+            default: return piece_none;                                                         // Пустая или неигровая клетка
+        }
+    }
+
+    // Преобразование кода фигуры в состояние клетки игрового поля (обратное к pieceCode)
+    static int cellState(int piece) {
+        switch (piece) {
+            case piece_white_man: return white_checker;
+            case piece_white_king: return black_king;                                       // Белая дамка хранится как black_king
+            case piece_black_man: return black_checker;
+            case piece_black_king: return white_king;                                       // Черная дамка хранится как white_king
+            default: return empty;
+        }
+    }
+
+    // Начальная позиция, построенная по маскам начальной расстановки
+    static Position initial() {
+        Position position;
+        for (int square = 0; square < Geometry::SQUARES; square++) {
+            typename Geometry::Mask bit = static_cast<typename Geometry::Mask>(typename Geometry::Mask(1) << square);
+            if (Geometry::WHITE_START_MASK & bit) position.squares[square] = piece_white_man;
+            else if (Geometry::BLACK_START_MASK & bit) position.squares[square] = piece_black_man;
+        }
+        return position;           // Первыми ходят белые
+    }
+
+    // Построение позиции по игровому полю
+    static Position fromBoard(const Board<Geometry>& board, int sideToMove) {
+        Position position;
+        for (int y = 0; y < Geometry::SIZE; y++) {
+            for (int x = 0; x < Geometry::SIZE; x++) {
+                if (Geometry::playable(x, y))
+                    position.squares[Geometry::squareIndex(x, y)] = pieceCode(board.getCell(x, y));
+            }
+        }
+        position.sideToMove = sideToMove;
+        return position;
+    }
+
+    // Перенос позиции на игровое поле (неигровые клетки не меняются)
+    void copyToBoard(Board<Geometry>& board) const {
+        for (int sq = 0; sq < Geometry::SQUARES; sq++)
+            board.setCell(squareX(sq), squareY(sq), cellState(squares[sq]));
+    }
+
+    // Координаты клетки по ее индексу (обратное преобразование к Geometry::squareIndex)
+    static int squareX(int square) {
+        int y = square / Geometry::ROW_SQUARES;
+        return (square % Geometry::ROW_SQUARES) * 2 + ((y & 1) ? 0 : 1); // В четных рядах игровые клетки на нечетных x
+    }
+    static int squareY(int square) {
+        return square / Geometry::ROW_SQUARES;
+    }
+};
+
+#endif // POSITION_H
@@ -0,0 +1,136 @@
+#include "Profiler.h"              // Подключаем объявление класса Profiler
+#include <atomic>                  // Подключаем атомарный счетчик записанных событий
+#include <chrono>                  // Подключаем монотонные часы
+#include <fstream>                 // Подключаем запись файла трассы
+#include <iostream>                // Подключаем вывод сообщений
+#include <mutex>                   // Подключаем мьютекс списка буферов
+#include <vector>                  // Подключаем std::vector
+
+namespace {
+
+// Событие трассы: участок кода и его время
+struct ProfileEvent {
+    const char* name;              // Имя участка
+    uint64_t start;                // Начало, нс
+    uint64_t duration;             // Длительность, нс
+};
+
+// Кольцевой буфер одного потока: пишет только владелец, читает dump
+struct ThreadBuffer {
+    int threadIndex;               // Номер потока в трассе
+    std::atomic<uint64_t> written; // Сколько событий записано за все время
+    ProfileEvent events[Profiler::BUFFER_EVENTS];
+};
+
+std::mutex buffersMutex;           // Защищает список буферов (регистрация потока и dump)
+std::vector<ThreadBuffer*> buffers; // Буферы всех потоков; не освобождаются, чтобы трасса пережила поток
+uint64_t origin = Profiler::now(); // Начало отсчета времени в трассе
+
+// Буфер текущего потока (создается при первом событии потока)
+ThreadBuffer* threadBuffer() {
+    static thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        buffer = new ThreadBuffer();
+        buffer->written.store(0, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(buffersMutex);
+        buffer->threadIndex = static_cast<int>(buffers.size()) + 1;
+        buffers.push_back(buffer);
+    }
+    return buffer;
+}
+
+// Имя участка как строка JSON
+void writeName(std::ostream& out, const char* name) {
+    out << '"';
+    for (const char* c = name; *c; c++) {
+        if (*c == '"' || *c == '\\') out << '\\';
+        out << *c;
+    }
+    out << '"';
+}
+
+} // namespace
+
+uint64_t Profiler::now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+bool Profiler::enabled() {
+#ifdef CHECKERS_PROFILE
+    return true;
+#else
+    return false;
+#endif
+}
+
+//
+// Запись события: событие кладется в ячейку кольца, затем публикуется увеличением счетчика
+//
+void Profiler::record(const char* name, uint64_t start, uint64_t end) {
+    ThreadBuffer* buffer = threadBuffer();
+    uint64_t index = buffer->written.load(std::memory_order_relaxed);
+    ProfileEvent& event = buffer->events[index & (BUFFER_EVENTS - 1)];
+    event.name = name;
+    event.start = start;
+    event.duration = end - start;
+    buffer->written.store(index + 1, std::memory_order_release);
+}
+
+//
+// Сохранение трассы: события "X" (полные интервалы) с временем в микросекундах от запуска программы.
+// Потоки продолжают писать во время сохранения, поэтому события, которые могли быть перезаписаны
+// за время копирования, отбрасываются
+//
+bool Profiler::dump(const std::string& path) {
+    if (!enabled()) {
+        std::cout << "Профилировщик отключен при сборке (соберите с make PROFILE=1)" << std::endl;
+        return false;
+    }
+    std::ofstream out(path.c_str());
+    if (!out) {
+        std::cout << "Не удалось создать файл трассы: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(buffersMutex);
+    out << std::fixed;
+    out.precision(3);              // Время в микросекундах с точностью до наносекунды
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    long long total = 0;
+    std::vector<ProfileEvent> copy;
+    for (size_t b = 0; b < buffers.size(); b++) {
+        ThreadBuffer* buffer = buffers[b];
+        uint64_t end = buffer->written.load(std::memory_order_acquire);
+        uint64_t begin = end > static_cast<uint64_t>(BUFFER_EVENTS) ? end - BUFFER_EVENTS : 0;
+        copy.clear();
+        for (uint64_t i = begin; i < end; i++)
+            copy.push_back(buffer->events[i & (BUFFER_EVENTS - 1)]);
+        uint64_t after = buffer->written.load(std::memory_order_acquire);
+        // Первое событие, которое не могло быть перезаписано: запись с номером after (возможно, еще идущая)
+        // занимает ячейку события after - BUFFER_EVENTS, поэтому оно тоже отбрасывается
+        uint64_t valid = after >= static_cast<uint64_t>(BUFFER_EVENTS) ? after - BUFFER_EVENTS + 1 : 0;
+        size_t skip = valid > begin ? static_cast<size_t>(valid - begin) : 0;
+
+        out << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadIndex
+            << ",\"args\":{\"name\":\"thread " << buffer->threadIndex << "\"}}";
+        first = false;
+        for (size_t i = skip; i < copy.size(); i++) {
+            const ProfileEvent& event = copy[i];
+            out << ",\n{\"name\":";
+            writeName(out, event.name);
+            out << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadIndex
+                << ",\"ts\":" << (event.start - origin) / 1000.0 << ",\"dur\":" << event.duration / 1000.0 << "}";
+            total++;
+        }
+    }
+    out << "\n]}\n";
+    out.close();
+    if (!out) {
+        std::cout << "Ошибка записи файла трассы: " << path << std::endl;
+        return false;
+    }
+    std::cout << "Трасса сохранена в " << path << ": событий " << total << ", потоков " << buffers.size() << std::endl;
+    return true;
+}
@@ -0,0 +1,43 @@
+#ifndef PROFILER_H                 // Защита от повторного включения заголовочного файла
+#define PROFILER_H
+
+#include <cstdint>                 // Подключаем целочисленные типы фиксированного размера
+#include <string>                  // Подключаем std::string для пути к файлу трассы
+
+//
+// Встроенный профилировщик горячих путей. PROFILE_SCOPE("имя") замеряет время до конца блока и пишет событие
+// в кольцевой буфер своего потока (без блокировок и выделения памяти). Profiler::dump сохраняет последние
+// события всех потоков в формате Chrome Trace Event (about:tracing, Perfetto).
+//
+// Замеры включаются при сборке с CHECKERS_PROFILE (make PROFILE=1); без него PROFILE_SCOPE не порождает кода.
+//
+class Profiler {
+public:
+    static const int BUFFER_EVENTS = 1 << 16; // Событий в кольцевом буфере одного потока (самые старые перезаписываются)
+
+    static uint64_t now();         // Текущее время в наносекундах (монотонные часы)
+    static void record(const char* name, uint64_t start, uint64_t end); // Запись события в буфер текущего потока
+    static bool dump(const std::string& path); // Сохранение трассы в JSON; false — ошибка или профилировщик выключен
+    static bool enabled();         // Собран ли профилировщик (CHECKERS_PROFILE)
+};
+
+// Замер времени от создания до выхода из блока
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : name(name), start(Profiler::now()) {}
+    ~ProfileScope() { Profiler::record(name, start, Profiler::now()); }
+
+private:
+    const char* name;              // Имя участка (строковый литерал: хранится только указатель)
+    uint64_t start;                // Время начала
+};
+
+#ifdef CHECKERS_PROFILE
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(name)
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#endif
+
+#endif // PROFILER_H
@@ -0,0 +1,252 @@
+#include "Rules.h"                 // Подключаем объявление класса Rules
+
+namespace {
+
+// Смещения четырех диагональных направлений: 0 и 1 — вверх (к ряду 0), 2 и 3 — вниз
+const int DIR_X[4] = { -1, 1, -1, 1 };
+const int DIR_Y[4] = { -1, -1, 1, 1 };
+
+//
+// Таблица соседей: для каждой игровой клетки и направления — индекс соседней клетки или -1
+//
+template <class Geometry>
+struct NeighborTable {
+    int8_t next[Geometry::SQUARES][4];
+
+    NeighborTable() {
+        for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+            int x = Position<Geometry>::squareX(sq);
+            int y = Position<Geometry>::squareY(sq);
+            for (int dir = 0; dir < 4; dir++) {
+                int nx = x + DIR_X[dir];
+                int ny = y + DIR_Y[dir];
+                next[sq][dir] = Geometry::inside(nx, ny) ? static_cast<int8_t>(Geometry::squareIndex(nx, ny)) : -1;
+            }
+        }
+    }
+};
+
+template <class Geometry>
+const NeighborTable<Geometry>& neighbors() {
+    static const NeighborTable<Geometry> table; // Строится один раз при первом обращении
+    return table;
+}
+
+// Достигла ли шашка стороны side ряда превращения на клетке square
+template <class Geometry>
+bool onPromotionRow(int square, int side) {
+    int row = Position<Geometry>::squareY(square);
+    return side == white_checker ? row == Geometry::WHITE_PROMOTION_ROW : row == Geometry::BLACK_PROMOTION_ROW;
+}
+
+//
+// Поиск цепочек взятий одной фигуры (обход в глубину).
+// Взятые шашки остаются на доске до конца хода и преграждают путь, но второй раз их бить нельзя.
+//
+template <class Geometry>
+class CaptureSearch {
+public:
+    typedef Position<Geometry> PositionType;
+    typedef typename Geometry::Mask Mask;
+
+    CaptureSearch(const PositionType& position, Move* moves, bool allPaths)
+        : position(position), table(neighbors<Geometry>()), moves(moves), count(0), longest(0), allPaths(allPaths),
+          from(-1), taken(0) {}
+
+    // Поиск всех взятий фигуры с клетки square; возвращает новое количество ходов в списке
+    int run(int square) {
+        from = square;
+        taken = 0;
+        current.from = static_cast<int8_t>(square);
+        current.captureCount = 0;
+        current.promotes = false;
+        int piece = position.squares[square];
+        search(square, Rules<Geometry>::isKing(piece), 0);
+        return count;
+    }
+
+    // Есть ли у фигуры на клетке square хотя бы одно взятие (без построения цепочек)
+    bool canStart(int square) {
+        from = square;
+        taken = 0;
+        return canContinue(square, Rules<Geometry>::isKing(position.squares[square]));
+    }
+
+private:
+    const PositionType& position;
+    const NeighborTable<Geometry>& table;
+    Move* moves;
+    int count;
+    int longest;                   // Наибольшее число взятых шашек среди записанных ходов
+    bool allPaths;                 // Оставлять разные пути с одним набором взятых шашек
+    int from;                      // Исходная клетка фигуры (во время хода она пуста)
+    Mask taken;                    // Уже взятые в текущей цепочке шашки
+    Move current;                  // Текущая цепочка взятий
+
+    static Mask bit(int square) { return static_cast<Mask>(Mask(1) << square); }
+
+    bool isFree(int square) const { return square == from || position.squares[square] == piece_none; }
+    bool isEnemy(int square) const {
+        int piece = position.squares[square];
+        return piece != piece_none && !Rules<Geometry>::isOwn(piece, position.sideToMove) && !(taken & bit(square));
+    }
+
+    // Клетка взятия в направлении dir для фигуры на square (или -1); для дамки — первая фигура на диагонали
+    int victim(int square, int dir, bool king) const {
+        int cur = table.next[square][dir];
+        if (king) {
+            while (cur >= 0 && isFree(cur))
+                cur = table.next[cur][dir];
+        }
+        if (cur < 0 || !isEnemy(cur)) return -1;
+        int land = table.next[cur][dir];
+        return (land >= 0 && isFree(land)) ? cur : -1;
+    }
+
+    // Может ли фигура продолжить взятие с клетки square
+    bool canContinue(int square, bool king) const {
+        for (int dir = 0; dir < 4; dir++) {
+            if (victim(square, dir, king) >= 0) return true;
+        }
+        return false;
+    }
+
+    bool reachesPromotion(int square) const {
+        return onPromotionRow<Geometry>(square, position.sideToMove);
+    }
+
+    void search(int square, bool king, int depth) {
+        bool extended = false;     // Удалось ли продолжить цепочку
+        for (int dir = 0; dir < 4; dir++) {
+            int captured = victim(square, dir, king);
+            if (captured < 0) continue;
+
+            taken |= bit(captured);
+            current.captured[depth] = static_cast<int8_t>(captured);
+            int land = table.next[captured][dir];
+            if (!king) {           // Простая шашка приземляется сразу за взятой
+                bool promoted = Geometry::PROMOTE_DURING_CAPTURE && reachesPromotion(land);
+                current.path[depth] = static_cast<int8_t>(land);
+                search(land, promoted, depth + 1);
+            } else {               // Дамка может встать на любую свободную клетку за взятой шашкой
+                bool mustContinue = false; // Если с какой-то клетки взятие продолжается, вставать можно только на такие клетки
+                for (int cur = land; cur >= 0 && isFree(cur); cur = table.next[cur][dir]) {
+                    if (canContinue(cur, true)) {
+                        mustContinue = true;
+                        break;
+                    }
+                }
+                for (int cur = land; cur >= 0 && isFree(cur); cur = table.next[cur][dir]) {
+                    if (mustContinue && !canContinue(cur, true)) continue;
+                    current.path[depth] = static_cast<int8_t>(cur);
+                    search(cur, true, depth + 1);
+                }
+            }
+            taken &= ~bit(captured);
+            extended = true;
+        }
+        if (!extended && depth > 0)
+            record(square, king, depth);
+    }
+
+    //
+    // Запись завершенной цепочки взятий в список ходов. Правило большинства применяется здесь, до ограничения
+    // MAX_MOVES: иначе переполнение списка короткими взятиями могло бы вытеснить самое длинное
+    //
+    void record(int square, bool king, int depth) {
+        if (Geometry::MAJORITY_CAPTURE) {
+            if (depth < longest) return;   // Есть взятие большего количества шашек
+            if (depth > longest) {         // Все записанные ранее взятия короче — они недопустимы
+                longest = depth;
+                count = 0;
+            }
+        }
+        if (count >= MAX_MOVES) return;
+        current.to = static_cast<int8_t>(square);
+        current.captureCount = static_cast<int8_t>(depth);
+        bool wasMan = !Rules<Geometry>::isKing(position.squares[from]);
+        current.promotes = wasMan && (king || reachesPromotion(square));
+        for (int i = 0; i < count && !allPaths; i++) { // Разные пути с тем же набором взятых шашек считаются одним ходом
+            const Move& other = moves[i];
+            if (other.from == current.from && other.to == current.to && other.captureCount == current.captureCount) {
+                Mask otherTaken = 0;
+                for (int c = 0; c < other.captureCount; c++)
+                    otherTaken |= bit(other.captured[c]);
+                if (otherTaken == taken) return;
+            }
+        }
+        moves[count++] = current;
+    }
+};
+
+} // namespace
+
+template <class Geometry>
+int Rules<Geometry>::neighbor(int square, int dir) {
+    return neighbors<Geometry>().next[square][dir];
+}
+
+//
+// Генерация ходов: если есть взятия, допустимы только они (для международных шашек — только самые длинные)
+//
+template <class Geometry>
+int Rules<Geometry>::generateMoves(const PositionType& position, Move* moves, bool allPaths) {
+    const int side = position.sideToMove;
+    int count = 0;
+    CaptureSearch<Geometry> search(position, moves, allPaths);
+    for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+        if (isOwn(position.squares[sq], side))
+            count = search.run(sq);    // Цепочки взятий каждой фигуры дописываются в общий список
+    }
+    if (count > 0)
+        return count;              // Взятие обязательно; для международных шашек остались только самые длинные
+
+    const NeighborTable<Geometry>& table = neighbors<Geometry>();
+    for (int sq = 0; sq < Geometry::SQUARES && count < MAX_MOVES; sq++) {
+        int piece = position.squares[sq];
+        if (!isOwn(piece, side)) continue;
+        bool king = isKing(piece);
+        for (int dir = 0; dir < 4 && count < MAX_MOVES; dir++) {
+            if (!king && (side == white_checker) != (DIR_Y[dir] > 0)) continue; // Простая шашка ходит только вперед
+            for (int cur = table.next[sq][dir]; cur >= 0 && position.squares[cur] == piece_none && count < MAX_MOVES;
+                 cur = table.next[cur][dir]) {
+                Move& move = moves[count++];
+                move.from = static_cast<int8_t>(sq);
+                move.to = static_cast<int8_t>(cur);
+                move.captureCount = 0;
+                move.promotes = !king && onPromotionRow<Geometry>(cur, side);
+                if (!king) break;  // Простая шашка ходит на одну клетку, дамка — на любое расстояние
+            }
+        }
+    }
+    return count;
+}
+
+//
+// Выполнение хода на позиции
+//
+template <class Geometry>
+void Rules<Geometry>::makeMove(PositionType& position, const Move& move) {
+    int8_t piece = position.squares[move.from];
+    position.squares[move.from] = piece_none;                   // Фигура покидает исходную клетку
+    for (int i = 0; i < move.captureCount; i++)
+        position.squares[move.captured[i]] = piece_none;        // Снимаем взятые шашки после завершения хода
+    if (move.promotes)
+        piece = (piece == piece_white_man) ? piece_white_king : piece_black_king; // Превращение в дамку
+    position.squares[move.to] = piece;
+    position.sideToMove = (position.sideToMove == white_checker) ? black_checker : white_checker; // Передаем ход
+}
+
+template <class Geometry>
+bool Rules<Geometry>::hasCapture(const PositionType& position) {
+    CaptureSearch<Geometry> search(position, nullptr, false);
+    for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+        if (isOwn(position.squares[sq], position.sideToMove) && search.canStart(sq))
+            return true;
+    }
+    return false;
+}
+
+// Явное инстанцирование для поддерживаемых вариантов доски
+template class Rules<Russian8x8>;
+template class Rules<International10x10>;
@@ -0,0 +1,50 @@
+#ifndef RULES_H                    // Защита от повторного включения заголовочного файла
+#define RULES_H
+
+#include "Position.h"              // Подключаем компактную позицию движка
+
+const int MAX_CAPTURES = 20;       // Наибольшее количество шашек, взятых за один ход (вся армия на доске 10x10)
+const int MAX_MOVES = 256;         // Наибольшее количество ходов в списке
+
+// Ход движка: вся цепочка взятий записывается одним ходом
+struct Move {
+    int8_t from;                   // Индекс исходной клетки
+    int8_t to;                     // Индекс конечной клетки
+    int8_t captureCount;           // Количество взятых шашек (0 — тихий ход)
+    bool promotes;                 // Шашка становится дамкой в результате хода
+    int8_t path[MAX_CAPTURES];     // Клетки приземления после каждого прыжка (последняя равна to)
+    int8_t captured[MAX_CAPTURES]; // Клетки взятых шашек в порядке взятия
+
+    bool isCapture() const { return captureCount > 0; }
+};
+
+//
+// Правила игры для движка: генерация допустимых ходов и их выполнение на компактной позиции.
+// В отличие от интерфейса игры, здесь соблюдаются обязательное взятие, правило турецкого удара
+// (взятые шашки снимаются только после хода) и, для международных шашек, правило большинства.
+//
+template <class Geometry>
+class Rules {
+public:
+    typedef Position<Geometry> PositionType;  // Тип позиции для данной геометрии
+
+    // Генерация всех допустимых ходов стороны, которая ходит; возвращает количество ходов (не больше MAX_MOVES).
+    // Взятия с одинаковым набором взятых шашек и конечной клеткой дают одну позицию и по умолчанию считаются
+    // одним ходом; allPaths оставляет все пути (интерфейсу и разбору записи нужен путь, выбранный игроком)
+    static int generateMoves(const PositionType& position, Move* moves, bool allPaths = false);
+    // Выполнение хода: перемещение фигуры, снятие взятых шашек, превращение в дамку и передача хода
+    static void makeMove(PositionType& position, const Move& move);
+    // Есть ли у стороны, которая ходит, хотя бы одно взятие
+    static bool hasCapture(const PositionType& position);
+
+    // Соседняя клетка по диагонали направления dir (0..3) или -1, если она за пределами доски
+    static int neighbor(int square, int dir);
+
+    static bool isWhite(int piece) { return piece == piece_white_man || piece == piece_white_king; }
+    static bool isBlack(int piece) { return piece == piece_black_man || piece == piece_black_king; }
+    static bool isKing(int piece) { return piece == piece_white_king || piece == piece_black_king; }
+    // Принадлежит ли фигура стороне side (white_checker или black_checker)
+    static bool isOwn(int piece, int side) { return side == white_checker ? isWhite(piece) : isBlack(piece); }
+};
+
+#endif // RULES_H
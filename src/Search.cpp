@@ -0,0 +1,209 @@
+#include "Search.h"                // Подключаем объявление класса Search
+#include <algorithm>               // Подключаем std::stable_sort и std::fill
+#include <cmath>                   // Подключаем std::lround
+
+namespace {
+
+const int INFINITE_SCORE = 32000;  // Больше любой оценки, включая выигрыш
+const int HISTORY_LIMIT = 1 << 20; // Порог статистики тихих ходов: ключ упорядочения остается меньше ключей взятий
+
+// Совпадают ли ходы (одинаковое начало, конец и путь взятия)
+bool sameMove(const Move& a, const Move& b) {
+    if (a.from != b.from || a.to != b.to || a.captureCount != b.captureCount) return false;
+    for (int i = 0; i < a.captureCount; i++)
+        if (a.path[i] != b.path[i] || a.captured[i] != b.captured[i]) return false;
+    return true;
+}
+
+} // namespace
+
+template <class Geometry>
+Search<Geometry>::Search(const Evaluator<Geometry>& evaluator)
+    : evaluator(evaluator), stopped(false), aborted(false), nodes(0), progressNodes(0)
+{
+    clearHistory();
+}
+
+template <class Geometry>
+void Search<Geometry>::clearHistory() {
+    for (int from = 0; from < Geometry::SQUARES; from++)
+        std::fill(history[from], history[from] + Geometry::SQUARES, 0);
+}
+
+//
+// Старение статистики: при достижении порога все значения делятся пополам. Соотношение между ходами
+// сохраняется, а долгий анализ (go infinite) не переполняет int
+//
+template <class Geometry>
+void Search<Geometry>::ageHistory() {
+    for (int from = 0; from < Geometry::SQUARES; from++)
+        for (int to = 0; to < Geometry::SQUARES; to++)
+            history[from][to] /= 2;
+}
+
+template <class Geometry>
+void Search<Geometry>::stop() {
+    stopped.store(true, std::memory_order_relaxed);
+}
+
+template <class Geometry>
+void Search<Geometry>::resetStop() {
+    stopped.store(false, std::memory_order_relaxed);
+}
+
+template <class Geometry>
+bool Search<Geometry>::limitReached() {
+    if (limits.nodes && nodes >= limits.nodes) return true;
+    if ((nodes & 1023) != 0) return false;        // Часы и счетчик для других потоков обновляются раз в 1024 узла
+    progressNodes.store(nodes, std::memory_order_relaxed);
+    if (limits.timeMs &&
+        std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - start).count() >= limits.timeMs)
+        return true;
+    return false;
+}
+
+//
+// Упорядочение: сначала ход из предыдущей итерации, затем взятия (больше взятых — раньше), затем тихие ходы
+// по статистике отсечений
+//
+template <class Geometry>
+void Search<Geometry>::orderMoves(Move* moves, int count, const Move* first) const {
+    int keys[MAX_MOVES];
+    int order[MAX_MOVES];
+    for (int i = 0; i < count; i++) {
+        order[i] = i;
+        if (first && sameMove(moves[i], *first)) keys[i] = 1 << 30;
+        else if (moves[i].isCapture()) keys[i] = (1 << 29) + moves[i].captureCount;
+        else keys[i] = history[moves[i].from][moves[i].to] + (moves[i].promotes ? (1 << 28) : 0);
+    }
+    std::stable_sort(order, order + count, [&keys](int a, int b) { return keys[a] > keys[b]; });
+    Move sorted[MAX_MOVES];
+    for (int i = 0; i < count; i++) sorted[i] = moves[order[i]];
+    std::copy(sorted, sorted + count, moves);
+}
+
+//
+// Продолжение взятий на листьях: взятие обязательно, поэтому при наличии взятий позиция не оценивается
+// (нельзя «отказаться» от взятия), а без взятий возвращается оценка
+//
+template <class Geometry>
+int Search<Geometry>::quiescence(const PositionType& position, int alpha, int beta, int ply) {
+    nodes++;
+    if (aborted || stopped.load(std::memory_order_relaxed) || limitReached()) {
+        aborted = true;
+        return 0;
+    }
+    pvLength[ply] = ply;
+    if (ply >= MAX_PLY - 1 || !Rules<Geometry>::hasCapture(position))
+        return static_cast<int>(std::lround(evaluator.evaluate(position)));
+
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves);
+    orderMoves(moves, count, nullptr);
+    for (int i = 0; i < count; i++) {
+        PositionType child = position;
+        Rules<Geometry>::makeMove(child, moves[i]);
+        int score = -quiescence(child, -beta, -alpha, ply + 1);
+        if (aborted) return 0;
+        if (score > alpha) {
+            alpha = score;
+            pv[ply][ply] = moves[i];
+            for (int j = ply + 1; j < pvLength[ply + 1]; j++) pv[ply][j] = pv[ply + 1][j];
+            pvLength[ply] = pvLength[ply + 1];
+            if (alpha >= beta) break;
+        }
+    }
+    return alpha;
+}
+
+template <class Geometry>
+int Search<Geometry>::alphaBeta(const PositionType& position, int depth, int alpha, int beta, int ply) {
+    if (depth <= 0)
+        return quiescence(position, alpha, beta, ply);
+    nodes++;
+    if (aborted || stopped.load(std::memory_order_relaxed) || limitReached()) {
+        aborted = true;
+        return 0;
+    }
+    Move previousBest;             // Лучший ход прошлой итерации (только в корне) проверяется первым
+    bool hasPrevious = (ply == 0 && pvLength[0] > 0);
+    if (hasPrevious) previousBest = pv[0][0];
+    pvLength[ply] = ply;
+
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves);
+    if (count == 0)
+        return -MATE + ply;        // Нет ходов — поражение (чем позже, тем лучше для проигравшего)
+    if (ply >= MAX_PLY - 1)
+        return static_cast<int>(std::lround(evaluator.evaluate(position)));
+
+    orderMoves(moves, count, hasPrevious ? &previousBest : nullptr);
+
+    for (int i = 0; i < count; i++) {
+        PositionType child = position;
+        Rules<Geometry>::makeMove(child, moves[i]);
+        int score = -alphaBeta(child, depth - 1, -beta, -alpha, ply + 1);
+        if (aborted) return 0;
+        if (score > alpha) {
+            alpha = score;
+            pv[ply][ply] = moves[i];
+            for (int j = ply + 1; j < pvLength[ply + 1]; j++) pv[ply][j] = pv[ply + 1][j];
+            pvLength[ply] = pvLength[ply + 1];
+            if (alpha >= beta) {
+                if (!moves[i].isCapture()) {       // Тихий ход дал отсечение
+                    int& value = history[moves[i].from][moves[i].to];
+                    value += depth * depth;
+                    if (value >= HISTORY_LIMIT) ageHistory();
+                }
+                break;
+            }
+        }
+    }
+    return alpha;
+}
+
+//
+// Итеративное углубление: каждая завершенная итерация сообщается обработчику, а результатом поиска
+// становится последняя завершенная итерация
+//
+template <class Geometry>
+bool Search<Geometry>::think(const PositionType& position, const SearchLimits& searchLimits, SearchInfo& info) {
+    limits = searchLimits;
+    start = Clock::now();
+    nodes = 0;
+    progressNodes.store(0, std::memory_order_relaxed);
+    aborted = false;
+    pvLength[0] = 0;
+
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves);
+    if (count == 0)
+        return false;
+
+    info.depth = 0;
+    info.score = 0;
+    info.pv.assign(1, moves[0]);   // Если не завершится даже первая итерация, ходим первым допустимым ходом
+    int maxDepth = (limits.depth > 0 && limits.depth < MAX_PLY - 1) ? limits.depth : MAX_PLY - 1;
+
+    for (int depth = 1; depth <= maxDepth; depth++) {
+        int score = alphaBeta(position, depth, -INFINITE_SCORE, INFINITE_SCORE, 0);
+        if (aborted)
+            break;                 // Незавершенная итерация не используется
+        info.depth = depth;
+        info.score = score;
+        info.nodes = nodes;
+        info.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+        info.pv.assign(pv[0], pv[0] + pvLength[0]);
+        if (handler) handler(info);
+        if (count == 1 || isMateScore(score))
+            break;                 // Единственный ход или найден форсированный выигрыш — дальше искать незачем
+    }
+    info.nodes = nodes;
+    info.seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    progressNodes.store(nodes, std::memory_order_relaxed);
+    return true;
+}
+
+// Явное инстанцирование для поддерживаемых вариантов доски
+template class Search<Russian8x8>;
+template class Search<International10x10>;
@@ -0,0 +1,79 @@
+#ifndef SEARCH_H                   // Защита от повторного включения заголовочного файла
+#define SEARCH_H
+
+#include "Evaluator.h"             // Подключаем оценку позиции
+#include "Rules.h"                 // Подключаем генерацию и выполнение ходов
+#include <atomic>                  // Подключаем атомарный флаг остановки
+#include <chrono>                  // Подключаем часы для ограничения по времени
+#include <cstdint>                 // Подключаем целочисленные типы фиксированного размера
+#include <functional>              // Подключаем std::function для обработчика промежуточных результатов
+#include <vector>                  // Подключаем std::vector для главного варианта
+
+// Ограничения поиска (0 — без ограничения)
+struct SearchLimits {
+    int depth;                     // Наибольшая глубина итеративного углубления
+    uint64_t nodes;                // Наибольшее количество узлов
+    int timeMs;                    // Наибольшее время, мс
+
+    SearchLimits() : depth(0), nodes(0), timeMs(0) {}
+};
+
+// Результат завершенной итерации поиска
+struct SearchInfo {
+    int depth;                     // Глубина итерации
+    int score;                     // Оценка с точки зрения стороны, которая ходит
+    uint64_t nodes;                // Узлов с начала поиска
+    double seconds;                // Время с начала поиска
+    std::vector<Move> pv;          // Главный вариант (первый ход — лучший)
+};
+
+//
+// Поиск лучшего хода: альфа-бета с итеративным углублением и форсированным продолжением взятий на листьях.
+// Оценка листьев — Evaluator. Поиск можно остановить из другого потока (stop); результат последней
+// завершенной итерации сохраняется. Флаг stop сбрасывает только resetStop, поэтому остановка, пришедшая
+// до начала think, не теряется. Один объект Search используется одним потоком.
+//
+template <class Geometry>
+class Search {
+public:
+    typedef Position<Geometry> PositionType;             // Тип позиции для данной геометрии
+    typedef std::function<void(const SearchInfo&)> InfoHandler; // Обработчик результата каждой итерации
+
+    static const int MATE = 30000;  // Оценка выигрыша (уменьшается на длину варианта)
+    static const int MAX_PLY = 64;  // Наибольшая глубина варианта
+
+    explicit Search(const Evaluator<Geometry>& evaluator);
+
+    // Поиск лучшего хода; false — у стороны, которая ходит, нет ходов (партия проиграна)
+    bool think(const PositionType& position, const SearchLimits& limits, SearchInfo& info);
+    void stop();                   // Остановка поиска (можно вызывать из любого потока, в том числе до think)
+    void resetStop();              // Сброс остановки перед новым поиском (вызывается до запуска потока поиска)
+    void setInfoHandler(const InfoHandler& value) { handler = value; } // Обработчик результата каждой итерации
+    void clearHistory();           // Сброс статистики упорядочения ходов (перед новой партией)
+    uint64_t getNodes() const { return progressNodes.load(std::memory_order_relaxed); } // Узлов текущего поиска (из любого потока, с точностью до 1024)
+
+    static bool isMateScore(int score) { return score > MATE - MAX_PLY || score < -MATE + MAX_PLY; }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    int alphaBeta(const PositionType& position, int depth, int alpha, int beta, int ply);
+    int quiescence(const PositionType& position, int alpha, int beta, int ply);
+    void orderMoves(Move* moves, int count, const Move* first) const; // Упорядочение ходов для отсечений
+    bool limitReached();           // Проверка ограничений по узлам и времени
+    void ageHistory();             // Уменьшение статистики тихих ходов вдвое (защита от переполнения)
+
+    const Evaluator<Geometry>& evaluator; // Оценка позиции
+    std::atomic<bool> stopped;     // Поиск остановлен извне (stop)
+    bool aborted;                  // Текущий поиск прерван: остановка или исчерпаны ограничения
+    SearchLimits limits;           // Ограничения текущего поиска
+    Clock::time_point start;       // Время начала поиска
+    uint64_t nodes;                // Счетчик узлов
+    std::atomic<uint64_t> progressNodes; // Копия счетчика узлов для других потоков
+    Move pv[MAX_PLY][MAX_PLY];     // Треугольная таблица главного варианта
+    int pvLength[MAX_PLY];         // Длина варианта на каждом уровне
+    int history[Geometry::SQUARES][Geometry::SQUARES]; // Статистика удачных тихих ходов (откуда, куда)
+    InfoHandler handler;           // Обработчик результата каждой итерации
+};
+
+#endif // SEARCH_H
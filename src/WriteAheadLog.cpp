@@ -0,0 +1,468 @@
+#include "WriteAheadLog.h"          // Подключаем объявление класса WriteAheadLog
+#include "Board.h"                 // Подключаем игровое поле: ходы из журнала выполняются тем же кодом, что и в игре
+#include "Profiler.h"              // Подключаем замеры времени горячих путей (PROFILE_SCOPE)
+#include <algorithm>               // Подключаем std::max
+#include <cerrno>                  // Подключаем errno
+#include <chrono>                  // Подключаем часы для измерения времени восстановления
+#include <cstddef>                 // Подключаем offsetof
+#include <cstring>                 // Подключаем std::memcpy и std::strerror
+#include <fcntl.h>                 // Подключаем open
+#include <fstream>                 // Подключаем чтение файла снимка
+#include <iostream>                // Подключаем вывод сообщений
+#include <sys/stat.h>              // Подключаем mkdir
+#include <unistd.h>                // Подключаем write, pread, fsync, fdatasync, ftruncate
+
+namespace {
+
+// Типы записей журнала
+enum RecordType {
+    record_start = 1,              // Начало новой партии
+    record_move = 2,               // Принятый ход
+    record_end = 3                 // Партия завершена
+};
+
+const char SNAPSHOT_MAGIC[4] = { 'C', 'K', 'S', 'N' }; // Сигнатура файла снимка
+const uint32_t SNAPSHOT_VERSION = 2;                    // Версия формата снимка (2 — добавлены режим и сторона игрока)
+
+// Дописывание значения в буфер снимка
+template <class T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+// Чтение значения из буфера снимка
+template <class T>
+bool get(const std::string& in, size_t& pos, T& value) {
+    if (pos + sizeof(value) > in.size()) return false;
+    std::memcpy(&value, in.data() + pos, sizeof(value));
+    pos += sizeof(value);
+    return true;
+}
+
+// Запись всего буфера в файл (write может записать только часть)
+bool writeAll(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += written;
+        size -= static_cast<size_t>(written);
+    }
+    return true;
+}
+
+// Начальная расстановка для новой партии
+template <class Geometry>
+void initialCells(JournalGame& game) {
+    Board<Geometry> board(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr); // Поле без текстур
+    game.cells.resize(Geometry::SIZE * Geometry::SIZE);
+    for (int y = 0; y < Geometry::SIZE; y++)
+        for (int x = 0; x < Geometry::SIZE; x++)
+            game.cells[y * Geometry::SIZE + x] = static_cast<int8_t>(board.getCell(x, y));
+}
+
+//
+// Выполнение хода из журнала так же, как Game::applyNetworkMove: Board::applyMove, затем смена хода
+// или продолжение взятия той же шашкой
+//
+template <class Geometry>
+void replayMove(JournalGame& game, int fromX, int fromY, int toX, int toY, uint8_t continuation) {
+    Board<Geometry> board(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr); // Поле без текстур
+    for (int y = 0; y < Geometry::SIZE; y++)
+        for (int x = 0; x < Geometry::SIZE; x++)
+            board.setCell(x, y, game.cells[y * Geometry::SIZE + x]);
+    board.applyMove(fromX, fromY, toX, toY, continuation == 0);
+    for (int y = 0; y < Geometry::SIZE; y++)
+        for (int x = 0; x < Geometry::SIZE; x++)
+            game.cells[y * Geometry::SIZE + x] = static_cast<int8_t>(board.getCell(x, y));
+
+    if (continuation == 0) {       // Ход завершен — ходит соперник
+        game.currentTurn = (game.currentTurn == white_checker) ? black_checker : white_checker;
+        game.selected = false;
+    } else {                       // Взятие продолжается той же шашкой
+        game.selected = true;
+        game.selectedX = toX;
+        game.selectedY = toY;
+    }
+}
+
+} // namespace
+
+WriteAheadLog::WriteAheadLog()
+    : fd(-1), nextGameId(1), nextSequence(1), durableSequence(0), snapshotSequence(0),
+      recordCount(0), syncCount(0), failed(false), stopping(false)
+{
+}
+
+WriteAheadLog::~WriteAheadLog() {
+    close();
+}
+
+//
+// Контрольная сумма FNV-1a
+//
+uint32_t WriteAheadLog::checksum(const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+//
+// Открытие журнала: чтение снимка, повтор записей после него, запуск потока групповой фиксации
+//
+bool WriteAheadLog::open(const std::string& dir) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    directory = dir;
+    logPath = directory + "/games.wal";
+    snapshotPath = directory + "/games.snapshot";
+
+    if (::mkdir(directory.c_str(), 0755) != 0 && errno != EEXIST) { // Каталог создается при первом запуске
+        std::cout << "Не удалось создать каталог журнала " << directory << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    if (!loadSnapshot())
+        return false;
+
+    fd = ::open(logPath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (fd < 0) {
+        std::cout << "Не удалось открыть журнал " << logPath << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    uint64_t replayed = 0;
+    if (!replayLog(replayed)) {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    durableSequence = nextSequence - 1;  // Все, что прочитано с диска, уже сохранено
+
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Журнал восстановлен за " << ms << " мс: активных партий " << games.size()
+              << ", записей после снимка " << replayed << std::endl;
+
+    stopping = false;
+    flusher = std::thread(&WriteAheadLog::flushLoop, this);
+    return true;
+}
+
+//
+// Чтение снимка активных партий (отсутствие снимка — пустое состояние)
+//
+bool WriteAheadLog::loadSnapshot() {
+    std::ifstream file(snapshotPath.c_str(), std::ios::binary);
+    if (!file) return true;
+    std::string data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    size_t pos = 0;
+    uint32_t version = 0, nextId = 0, count = 0, stored = 0;
+    uint64_t sequence = 0;
+    bool ok = data.size() >= sizeof(SNAPSHOT_MAGIC) + sizeof(stored) &&
+              std::memcmp(data.data(), SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) == 0;
+    if (ok) {
+        size_t body = data.size() - sizeof(stored);      // Контрольная сумма хранится в конце файла
+        std::memcpy(&stored, data.data() + body, sizeof(stored));
+        ok = stored == checksum(data.data(), body);
+        data.resize(body);
+    }
+    pos = sizeof(SNAPSHOT_MAGIC);
+    ok = ok && get(data, pos, version) && (version == 1 || version == SNAPSHOT_VERSION) &&
+         get(data, pos, sequence) && get(data, pos, nextId) && get(data, pos, count);
+
+    for (uint32_t i = 0; ok && i < count; i++) {
+        JournalGame game;
+        uint8_t size = 0, mode = 0, localPlayer = 0, turn = 0, selected = 0, selectedX = 0, selectedY = 0;
+        ok = get(data, pos, game.gameId) && get(data, pos, size) &&
+             (version == 1 || (get(data, pos, mode) && get(data, pos, localPlayer))) && // В версии 1 режима нет: такая партия не продолжается
+             get(data, pos, turn) && get(data, pos, selected) && get(data, pos, selectedX) && get(data, pos, selectedY) &&
+             pos + size * size <= data.size();
+        if (!ok) break;
+        game.boardSize = size;
+        game.mode = mode;
+        game.localPlayer = localPlayer;
+        game.currentTurn = turn;
+        game.selected = selected != 0;
+        game.selectedX = selectedX;
+        game.selectedY = selectedY;
+        game.cells.assign(data.begin() + pos, data.begin() + pos + size * size);
+        pos += size * size;
+        games[game.gameId] = game;
+    }
+    if (!ok || pos != data.size()) { // Снимок заменяется атомарно, поэтому повреждение — не обрыв записи, а ошибка
+        std::cout << "Снимок журнала поврежден: " << snapshotPath << std::endl;
+        games.clear();
+        return false;
+    }
+    snapshotSequence = sequence;
+    nextSequence = sequence + 1;
+    nextGameId = nextId;
+    return true;
+}
+
+//
+// Повтор записей журнала после снимка. Запись, оборванная при сбое (неполная или с неверной контрольной суммой),
+// и все, что за ней, отрезаются
+//
+bool WriteAheadLog::replayLog(uint64_t& replayed) {
+    replayed = 0;
+    off_t offset = 0;
+    Record record;
+    while (true) {
+        ssize_t got = ::pread(fd, &record, sizeof(record), offset);
+        if (got < 0 && errno == EINTR) continue;
+        if (got != static_cast<ssize_t>(sizeof(record)) ||
+            record.checksum != checksum(&record, offsetof(Record, checksum)) ||
+            (record.sequence > snapshotSequence && record.sequence < nextSequence))
+            break;                 // Конец журнала или оборванный хвост
+        if (record.sequence > snapshotSequence) { // Записи до снимка уже учтены в нем
+            apply(record);
+            nextSequence = record.sequence + 1;
+            replayed++;
+        }
+        offset += sizeof(record);
+    }
+
+    struct stat info;
+    if (::fstat(fd, &info) == 0 && info.st_size != offset) {
+        std::cout << "Журнал обрезан после последней целой записи: отброшено "
+                  << (info.st_size - offset) << " байт" << std::endl;
+        if (::ftruncate(fd, offset) != 0 || ::fdatasync(fd) != 0) {
+            std::cout << "Не удалось обрезать журнал: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+//
+// Применение записи к состоянию активных партий; false — запись не относится ни к одной партии
+//
+bool WriteAheadLog::apply(const Record& record) {
+    if (record.type == record_start) {
+        if (record.boardSize != Russian8x8::SIZE && record.boardSize != International10x10::SIZE)
+            return false;
+        JournalGame game;
+        game.gameId = record.gameId;
+        game.boardSize = record.boardSize;
+        game.mode = record.fromX;
+        game.localPlayer = record.fromY;
+        game.currentTurn = white_checker;    // Первыми ходят белые
+        game.selected = false;
+        game.selectedX = game.selectedY = 0;
+        if (game.boardSize == International10x10::SIZE) initialCells<International10x10>(game);
+        else initialCells<Russian8x8>(game);
+        games[game.gameId] = game;
+        if (record.gameId >= nextGameId) nextGameId = record.gameId + 1;
+        return true;
+    }
+
+    std::map<uint32_t, JournalGame>::iterator it = games.find(record.gameId);
+    if (it == games.end())
+        return false;
+    if (record.type == record_end) {
+        games.erase(it);
+        return true;
+    }
+    JournalGame& game = it->second;
+    if (record.type != record_move || record.fromX >= game.boardSize || record.fromY >= game.boardSize ||
+        record.toX >= game.boardSize || record.toY >= game.boardSize)
+        return false;
+    if (game.boardSize == International10x10::SIZE)
+        replayMove<International10x10>(game, record.fromX, record.fromY, record.toX, record.toY, record.continuation);
+    else
+        replayMove<Russian8x8>(game, record.fromX, record.fromY, record.toX, record.toY, record.continuation);
+    return true;
+}
+
+std::vector<JournalGame> WriteAheadLog::activeGames() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<JournalGame> result;
+    for (std::map<uint32_t, JournalGame>::const_iterator it = games.begin(); it != games.end(); ++it)
+        result.push_back(it->second);
+    return result;
+}
+
+uint32_t WriteAheadLog::newGameId() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextGameId++;
+}
+
+//
+// Добавление записи: состояние партии меняется сразу, на диск запись попадает со следующей группой
+//
+uint64_t WriteAheadLog::append(Record record) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd < 0 || stopping || !apply(record))
+        return 0;                  // Журнал закрыт или запись не относится к активной партии — ждать нечего
+    record.sequence = nextSequence++;
+    record.checksum = checksum(&record, offsetof(Record, checksum));
+    pending.push_back(record);
+    pendingChanged.notify_one();
+    return record.sequence;
+}
+
+uint64_t WriteAheadLog::logStart(uint32_t gameId, int boardSize, int mode, int localPlayer) {
+    Record record = Record();
+    record.type = record_start;
+    record.gameId = gameId;
+    record.boardSize = static_cast<uint8_t>(boardSize);
+    record.fromX = static_cast<uint8_t>(mode);
+    record.fromY = static_cast<uint8_t>(localPlayer);
+    return append(record);
+}
+
+uint64_t WriteAheadLog::logMove(uint32_t gameId, int fromX, int fromY, int toX, int toY, uint8_t continuation) {
+    Record record = Record();
+    record.type = record_move;
+    record.gameId = gameId;
+    record.fromX = static_cast<uint8_t>(fromX);
+    record.fromY = static_cast<uint8_t>(fromY);
+    record.toX = static_cast<uint8_t>(toX);
+    record.toY = static_cast<uint8_t>(toY);
+    record.continuation = continuation;
+    return append(record);
+}
+
+uint64_t WriteAheadLog::logEnd(uint32_t gameId) {
+    Record record = Record();
+    record.type = record_end;
+    record.gameId = gameId;
+    return append(record);
+}
+
+//
+// Поток групповой фиксации: забирает все накопившиеся записи, пишет их одним вызовом write и одним fdatasync.
+// Пока идет синхронизация, новые записи копятся в очереди и уходят следующей группой
+//
+void WriteAheadLog::flushLoop() {
+    std::vector<Record> batch;
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        pendingChanged.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty())
+            break;                 // Остановка, и все записи уже на диске
+        batch.swap(pending);
+        lock.unlock();
+
+        bool ok;
+        {
+            std::lock_guard<std::mutex> fileLock(fileMutex);
+            ok = writeAll(fd, reinterpret_cast<const char*>(batch.data()), batch.size() * sizeof(Record)) &&
+                 ::fdatasync(fd) == 0;
+        }
+
+        lock.lock();
+        if (ok) {
+            durableSequence = std::max(durableSequence, batch.back().sequence); // compact мог уже поднять границу дальше
+            recordCount += batch.size();
+            syncCount++;
+        } else if (!failed) {
+            failed = true;
+            std::cout << "Ошибка записи журнала: " << std::strerror(errno) << std::endl;
+        }
+        batch.clear();
+        durableChanged.notify_all();
+    }
+}
+
+void WriteAheadLog::waitDurable(uint64_t sequence) {
+    PROFILE_SCOPE("WriteAheadLog::waitDurable"); // Ожидание fdatasync видно на трассе кадра
+    std::unique_lock<std::mutex> lock(mutex);
+    durableChanged.wait(lock, [this, sequence] { return durableSequence >= sequence || failed; });
+}
+
+//
+// Снимок активных партий. Снимок пишется во временный файл и атомарно заменяет старый (rename), после чего
+// журнал обрезается: все записи в файле журнала уже учтены в снимке, а записи из очереди, попавшие
+// в снимок, при восстановлении пропускаются по номеру
+//
+bool WriteAheadLog::compact() {
+    std::lock_guard<std::mutex> fileLock(fileMutex); // Поток записи не пишет в журнал, пока идет обрезка
+    if (fd < 0) return false;
+
+    std::string data(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    uint64_t covered;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        covered = nextSequence - 1;
+        put(data, SNAPSHOT_VERSION);
+        put(data, covered);
+        put(data, nextGameId);
+        put(data, static_cast<uint32_t>(games.size()));
+        for (std::map<uint32_t, JournalGame>::const_iterator it = games.begin(); it != games.end(); ++it) {
+            const JournalGame& game = it->second;
+            put(data, game.gameId);
+            put(data, static_cast<uint8_t>(game.boardSize));
+            put(data, static_cast<uint8_t>(game.mode));
+            put(data, static_cast<uint8_t>(game.localPlayer));
+            put(data, static_cast<uint8_t>(game.currentTurn));
+            put(data, static_cast<uint8_t>(game.selected ? 1 : 0));
+            put(data, static_cast<uint8_t>(game.selectedX));
+            put(data, static_cast<uint8_t>(game.selectedY));
+            data.append(reinterpret_cast<const char*>(game.cells.data()), game.cells.size());
+        }
+    }
+    put(data, checksum(data.data(), data.size()));
+
+    std::string temporaryPath = snapshotPath + ".tmp";
+    int snapshot = ::open(temporaryPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    bool ok = snapshot >= 0;
+    ok = ok && writeAll(snapshot, data.data(), data.size()) && ::fsync(snapshot) == 0;
+    if (snapshot >= 0) ::close(snapshot);
+    ok = ok && ::rename(temporaryPath.c_str(), snapshotPath.c_str()) == 0;
+    if (ok) {                      // Переименование становится надежным только после синхронизации каталога
+        int dirFd = ::open(directory.c_str(), O_RDONLY);
+        ok = dirFd >= 0 && ::fsync(dirFd) == 0;
+        if (dirFd >= 0) ::close(dirFd);
+    }
+    if (!ok) {
+        std::cout << "Не удалось сохранить снимок журнала: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (::ftruncate(fd, 0) != 0 || ::fdatasync(fd) != 0) { // Снимок уже надежен, поэтому неудача здесь безопасна
+        std::cout << "Не удалось обрезать журнал: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    snapshotSequence = covered;
+    if (durableSequence < covered) durableSequence = covered; // Записи из очереди сохранены в снимке
+    durableChanged.notify_all();
+    return true;
+}
+
+uint64_t WriteAheadLog::recordsSinceSnapshot() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return nextSequence - 1 - snapshotSequence;
+}
+
+uint64_t WriteAheadLog::getRecordCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return recordCount;
+}
+
+uint64_t WriteAheadLog::getSyncCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return syncCount;
+}
+
+void WriteAheadLog::close() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    pendingChanged.notify_all();
+    if (flusher.joinable())
+        flusher.join();            // Поток записи завершается, только когда очередь пуста
+    std::lock_guard<std::mutex> lock(mutex);
+    if (fd >= 0) {
+        std::cout << "Журнал закрыт: записей " << recordCount << ", вызовов fdatasync " << syncCount << std::endl;
+        ::close(fd);
+        fd = -1;
+    }
+}
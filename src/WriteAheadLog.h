@@ -0,0 +1,99 @@
+#ifndef WRITEAHEADLOG_H            // Защита от повторного включения заголовочного файла
+#define WRITEAHEADLOG_H
+
+#include <condition_variable>      // Подключаем условные переменные для ожидания записи на диск
+#include <cstddef>                 // Подключаем size_t
+#include <cstdint>                 // Подключаем целочисленные типы фиксированного размера
+#include <map>                     // Подключаем std::map для активных партий
+#include <mutex>                   // Подключаем мьютексы
+#include <string>                  // Подключаем std::string для путей к файлам
+#include <thread>                  // Подключаем поток записи журнала
+#include <vector>                  // Подключаем std::vector
+
+// Состояние партии в журнале (то, что Game хранит в Board, currentTurn и selected)
+struct JournalGame {
+    uint32_t gameId;               // Идентификатор партии
+    int boardSize;                 // Размер доски (8 или 10)
+    int mode;                      // Режим игры, в котором начата партия (1–4, как в меню Game::init)
+    int localPlayer;               // Сторона локального игрока (0 — локальная игра за обе стороны)
+    std::vector<int8_t> cells;     // Состояния клеток (CellState) построчно, boardSize * boardSize значений
+    int currentTurn;               // Сторона, которая ходит (white_checker или black_checker)
+    bool selected;                 // Шашка продолжает взятие и остается выделенной
+    int selectedX, selectedY;      // Координаты этой шашки
+};
+
+//
+// Журнал упреждающей записи (write-ahead log) для партий, идущих в данный момент.
+// Каждый принятый ход дописывается в журнал; фоновый поток записывает на диск все накопившиеся
+// записи всех партий одним вызовом fdatasync (групповая фиксация), поэтому стоимость синхронизации
+// делится между всеми ходами, пришедшими за время предыдущей записи.
+//
+// Журнал сам ведет состояние активных партий: при открытии оно восстанавливается из последнего снимка
+// и записей после него, а compact() сохраняет новый снимок и обрезает файл журнала.
+//
+class WriteAheadLog {
+public:
+    WriteAheadLog();               // Конструктор: журнал еще не открыт
+    ~WriteAheadLog();              // Деструктор: дописывает оставшиеся записи и закрывает файл
+
+    bool open(const std::string& directory); // Открытие журнала в каталоге: восстановление партий и запуск потока записи
+    void close();                  // Запись оставшихся записей, остановка потока и закрытие файла
+
+    std::vector<JournalGame> activeGames() const; // Активные (не завершенные) партии
+    uint32_t newGameId();          // Идентификатор для новой партии
+
+    // Добавление записей; возвращают порядковый номер записи для waitDurable
+    uint64_t logStart(uint32_t gameId, int boardSize, int mode, int localPlayer); // Начало новой партии
+    uint64_t logMove(uint32_t gameId, int fromX, int fromY, int toX, int toY, uint8_t continuation); // Принятый ход
+    uint64_t logEnd(uint32_t gameId);                              // Партия завершена и больше не восстанавливается
+
+    void waitDurable(uint64_t sequence); // Ожидание, пока запись с этим номером (и все предыдущие) окажутся на диске
+
+    bool compact();                // Снимок активных партий и обрезка журнала
+    uint64_t recordsSinceSnapshot() const; // Количество записей после последнего снимка
+    uint64_t getRecordCount() const;   // Всего записей, сохраненных на диске
+    uint64_t getSyncCount() const;     // Всего вызовов fdatasync (записей на вызов — средний размер группы)
+
+private:
+    // Запись журнала фиксированного размера (24 байта) с контрольной суммой: оборванная при сбое запись отбрасывается
+    struct Record {
+        uint64_t sequence;         // Порядковый номер записи
+        uint32_t gameId;           // Идентификатор партии
+        uint8_t type;              // Тип записи (начало партии, ход, конец партии)
+        uint8_t boardSize;         // Размер доски (для записи о начале партии)
+        uint8_t fromX, fromY, toX, toY; // Координаты хода (в записи о начале партии fromX — режим, fromY — сторона игрока)
+        uint8_t continuation;      // Флаг продолжения взятия (как в сетевом пакете)
+        uint8_t reserved;          // Выравнивание
+        uint32_t checksum;         // Контрольная сумма предыдущих полей
+    };
+
+    uint64_t append(Record record); // Применение записи к состоянию и постановка в очередь на запись
+    bool apply(const Record& record); // Применение записи к состоянию активных партий
+    void flushLoop();              // Цикл фонового потока групповой фиксации
+    bool loadSnapshot();           // Чтение снимка
+    bool replayLog(uint64_t& replayed); // Повтор записей журнала после снимка (оборванный хвост отрезается)
+    static uint32_t checksum(const void* data, size_t size); // Контрольная сумма FNV-1a
+
+    std::string directory;         // Каталог журнала
+    std::string logPath;           // Путь к файлу журнала
+    std::string snapshotPath;      // Путь к файлу снимка
+    int fd;                        // Дескриптор файла журнала (-1 — не открыт)
+
+    mutable std::mutex mutex;      // Защищает состояние партий, очередь и счетчики
+    std::mutex fileMutex;          // Защищает файл журнала: запись группы и обрезка не пересекаются
+    std::condition_variable pendingChanged;  // Сигнал потоку записи о новых записях
+    std::condition_variable durableChanged;  // Сигнал ожидающим о завершении fdatasync
+    std::map<uint32_t, JournalGame> games;   // Активные партии по идентификатору
+    std::vector<Record> pending;   // Записи, ожидающие записи на диск
+    uint32_t nextGameId;           // Следующий свободный идентификатор партии
+    uint64_t nextSequence;         // Номер следующей записи
+    uint64_t durableSequence;      // Номер последней записи, гарантированно сохраненной на диске
+    uint64_t snapshotSequence;     // Номер последней записи, учтенной в снимке
+    uint64_t recordCount;          // Статистика: записей на диске
+    uint64_t syncCount;            // Статистика: вызовов fdatasync
+    bool failed;                   // Ошибка записи на диск: ожидающие больше не блокируются
+    bool stopping;                 // Поток записи должен завершиться
+    std::thread flusher;           // Фоновый поток групповой фиксации
+};
+
+#endif // WRITEAHEADLOG_H
@@ -1,11 +1,36 @@
 #include "Game.h"           // Подключаем заголовочный файл Game.h, содержащий объявление класса Game
+#include <cstring>          // Подключаем std::strcmp для разбора аргументов командной строки
 
-int main() {                // Точка входа в программу
-    Game game;            // Создаем объект game класса Game, который управляет игрой
+// Запуск партии на доске заданной геометрии
+template <class Geometry>
+static int play(const char* journalDirectory, const char* traceFile) {
+    Game<Geometry> game;  // Создаем объект game класса Game, который управляет игрой
+    if (journalDirectory) // Если указан каталог журнала, партия переживет перезапуск программы
+        game.enableJournal(journalDirectory);
+    if (traceFile)        // Если указан файл трассы, профилировщик сохранит ее при выходе
+        game.enableTrace(traceFile);
     if (!game.init())     // Вызываем метод init() для инициализации игры; если инициализация не удалась
         return -1;        // Завершаем программу с кодом ошибки -1
     
     game.run();           // Запускаем основной игровой цикл с помощью метода run()
     
     return 0;             // Завершаем программу с кодом 0, что означает успешное выполнение
-}
\ No newline at end of file
+}
+
+int main(int argc, char* argv[]) { // Точка входа в программу
+    bool international = false;    // По умолчанию играем в русские шашки на доске 8x8
+    const char* journalDirectory = nullptr; // По умолчанию журнал партий не ведется
+    const char* traceFile = nullptr; // По умолчанию трасса профилировщика сохраняется только по F12
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--10x10") == 0)
+            international = true;  // Флаг --10x10 включает международные шашки на доске 10x10
+        else if (std::strcmp(argv[i], "--journal") == 0 && i + 1 < argc)
+            journalDirectory = argv[++i]; // Флаг --journal <каталог> включает журнал упреждающей записи
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            traceFile = argv[++i]; // Флаг --trace <файл> сохраняет трассу профилировщика при выходе
+    }
+    
+    if (international)
+        return play<International10x10>(journalDirectory, traceFile);
+    return play<Russian8x8>(journalDirectory, traceFile);
+}
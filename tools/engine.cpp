@@ -0,0 +1,401 @@
+#include "Notation.h"              // Подключаем запись ходов и позиций в нотации PDN
+#include "Search.h"                // Подключаем поиск лучшего хода
+#include <chrono>                  // Подключаем часы для статистики поиска
+#include <condition_variable>     // Подключаем ожидание остановки анализа
+#include <cstdlib>                 // Подключаем std::atoi, std::atof и std::strtoull
+#include <cstring>                 // Подключаем std::strcmp
+#include <iostream>                // Подключаем обмен командами через stdin/stdout
+#include <map>                     // Подключаем аргументы команд "имя=значение"
+#include <mutex>                   // Подключаем мьютексы вывода и состояния поиска
+#include <sstream>                 // Подключаем сборку строк ответа
+#include <string>                  // Подключаем std::string
+#include <thread>                  // Подключаем поток поиска
+#include <vector>                  // Подключаем std::vector
+
+//
+// checkers-engine: движок без окна, управляемый по протоколу Hub (строки через stdin/stdout, как у Scan).
+// Поиск идет в отдельном потоке, поэтому stop и ping обрабатываются сразу. Поддерживаемые команды:
+//   hub                                    -> id ..., param ..., wait
+//   init                                   -> ready
+//   ping                                   -> pong
+//   set-param name=weights value=<файл>    загрузка весов оценки
+//   new-game                               сброс статистики упорядочения ходов
+//   pos [pos=<позиция Hub>|fen=<FEN>] [moves="32-28 19x28 ..."]
+//   level depth=N | nodes=N | move-time=с | infinite | time=с [inc=с] [moves=N]
+//   time left=с                            оставшееся время при контроле time/inc
+//   go think | go ponder | go analyze      -> info ... (после каждой итерации и раз в секунду), done move=... ponder=...
+//   stop                                   досрочное завершение поиска (анализ без ограничений ждет stop)
+//   quit
+//
+// Позиция Hub: сторона (W или B) и клетки 1..N по порядку номеров (w, b — шашки, W, B — дамки, e — пусто).
+// Ход Hub: "32-28" или "28x19x23" (откуда, куда, затем взятые клетки); на входе принимается и запись PDN.
+//
+// Использование: checkers-engine [--10x10] [--weights файл]
+//
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Аргументы команды: пары "имя=значение" (значение может быть в кавычках) и отдельные слова (значение пустое)
+std::map<std::string, std::string> parseArguments(const std::string& line, std::string& command) {
+    std::map<std::string, std::string> arguments;
+    size_t i = 0;
+    command.clear();
+    while (i < line.size()) {
+        while (i < line.size() && line[i] == ' ') i++;
+        if (i >= line.size()) break;
+        size_t start = i;
+        while (i < line.size() && line[i] != ' ' && line[i] != '=') i++;
+        std::string name = line.substr(start, i - start);
+        std::string value;
+        if (i < line.size() && line[i] == '=') {
+            i++;
+            if (i < line.size() && line[i] == '"') {
+                size_t end = line.find('"', i + 1);
+                if (end == std::string::npos) end = line.size();
+                value = line.substr(i + 1, end - i - 1);
+                i = end + 1;
+            } else {
+                start = i;
+                while (i < line.size() && line[i] != ' ') i++;
+                value = line.substr(start, i - start);
+            }
+        }
+        if (command.empty()) command = name;
+        else arguments[name] = value;
+    }
+    return arguments;
+}
+
+//
+// Движок Hub для одной геометрии доски
+//
+template <class Geometry>
+class HubEngine {
+public:
+    typedef Position<Geometry> PositionType;
+
+    HubEngine() : search(evaluator), position(PositionType::initial()), infinite(false), timeLeft(0.0),
+                  increment(0.0), movesToGo(0), stopRequested(false), thinking(false) {
+        search.setInfoHandler([this](const SearchInfo& info) { reportIteration(info); });
+    }
+
+    bool loadWeights(const std::string& path) { return evaluator.loadWeights(path); }
+    int run();                     // Цикл чтения команд до quit или конца ввода
+
+private:
+    void send(const std::string& line);   // Строка ответа (из любого потока)
+    void error(const std::string& message) { send("error message=\"" + message + "\""); }
+
+    static std::string moveToHub(const Move& move);
+    static bool parseMove(const PositionType& position, const std::string& text, Move& move);
+    static bool parsePosition(const std::string& text, PositionType& result);
+
+    void handlePos(std::map<std::string, std::string>& arguments);
+    void handleLevel(std::map<std::string, std::string>& arguments);
+    void handleGo(std::map<std::string, std::string>& arguments);
+    void requestStop();            // Остановка поиска без ожидания (ответ done пришлет поток поиска)
+    void finishSearch();           // Остановка поиска и ожидание его потока
+    void searchMain(PositionType root, SearchLimits limits, bool analyze);
+    void reportIteration(const SearchInfo& info);
+
+    Evaluator<Geometry> evaluator; // Оценка позиции
+    Search<Geometry> search;       // Поиск (используется только потоком поиска)
+    PositionType position;         // Текущая позиция (pos)
+    SearchLimits level;            // Ограничения из level
+    bool infinite;                 // level infinite
+    double timeLeft, increment;    // Контроль времени: остаток и добавка за ход, секунды
+    int movesToGo;                 // Ходов до следующего контроля (0 — вся партия)
+
+    std::thread worker;            // Поток текущего поиска
+    std::mutex stateMutex;         // Защищает stopRequested и thinking
+    std::condition_variable stateChanged; // Сигнал об остановке или окончании поиска
+    bool stopRequested;            // Получена команда stop
+    bool thinking;                 // Поиск еще идет (для ежесекундных сообщений)
+    Clock::time_point searchStart; // Начало текущего поиска
+    std::mutex outputMutex;        // Строки из разных потоков не перемешиваются
+};
+
+template <class Geometry>
+void HubEngine<Geometry>::send(const std::string& line) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::cout << line << std::endl;
+}
+
+//
+// Ход в записи Hub: для взятия после конечной клетки перечисляются взятые клетки
+//
+template <class Geometry>
+std::string HubEngine<Geometry>::moveToHub(const Move& move) {
+    std::ostringstream out;
+    out << Notation<Geometry>::squareNumber(move.from) << (move.isCapture() ? 'x' : '-')
+        << Notation<Geometry>::squareNumber(move.to);
+    for (int i = 0; i < move.captureCount; i++)
+        out << 'x' << Notation<Geometry>::squareNumber(move.captured[i]);
+    return out.str();
+}
+
+//
+// Разбор хода: сначала запись Hub (откуда, куда и набор взятых клеток), затем запись PDN с клетками приземления
+//
+template <class Geometry>
+bool HubEngine<Geometry>::parseMove(const PositionType& position, const std::string& text, Move& move) {
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves);
+    for (int m = 0; m < count; m++) {
+        if (moveToHub(moves[m]) == text) {
+            move = moves[m];
+            return true;
+        }
+    }
+    std::vector<int> numbers;      // Номера клеток из записи
+    std::istringstream items(text);
+    std::string item;
+    while (std::getline(items, item, 'x'))
+        numbers.push_back(std::atoi(item.c_str()));
+    if (numbers.size() > 2) {      // Взятые клетки могут быть перечислены в любом порядке
+        for (int m = 0; m < count; m++) {
+            const Move& candidate = moves[m];
+            if (static_cast<int>(numbers.size()) - 2 != candidate.captureCount ||
+                Notation<Geometry>::squareNumber(candidate.from) != numbers[0] ||
+                Notation<Geometry>::squareNumber(candidate.to) != numbers[1])
+                continue;
+            bool matches = true;
+            for (size_t k = 2; k < numbers.size() && matches; k++) {
+                matches = false;
+                for (int c = 0; c < candidate.captureCount; c++)
+                    if (Notation<Geometry>::squareNumber(candidate.captured[c]) == numbers[k]) matches = true;
+            }
+            if (matches) {
+                move = candidate;
+                return true;
+            }
+        }
+    }
+    return Notation<Geometry>::parseMove(position, text, move);
+}
+
+template <class Geometry>
+bool HubEngine<Geometry>::parsePosition(const std::string& text, PositionType& result) {
+    if (static_cast<int>(text.size()) != Geometry::SQUARES + 1) return false;
+    PositionType parsed;
+    if (text[0] == 'W' || text[0] == 'w') parsed.sideToMove = white_checker;
+    else if (text[0] == 'B' || text[0] == 'b') parsed.sideToMove = black_checker;
+    else return false;
+    for (int number = 1; number <= Geometry::SQUARES; number++) {
+        int8_t piece;
+        switch (text[number]) {
+            case 'w': piece = piece_white_man; break;
+            case 'W': piece = piece_white_king; break;
+            case 'b': piece = piece_black_man; break;
+            case 'B': piece = piece_black_king; break;
+            case 'e': piece = piece_none; break;
+            default: return false;
+        }
+        parsed.squares[Notation<Geometry>::squareIndex(number)] = piece;
+    }
+    result = parsed;
+    return true;
+}
+
+template <class Geometry>
+void HubEngine<Geometry>::handlePos(std::map<std::string, std::string>& arguments) {
+    PositionType parsed = PositionType::initial();
+    if (arguments.count("pos") && !parsePosition(arguments["pos"], parsed)) {
+        error("bad position " + arguments["pos"]);
+        return;
+    }
+    if (arguments.count("fen") && !Notation<Geometry>::parseFen(arguments["fen"], parsed)) {
+        error("bad fen " + arguments["fen"]);
+        return;
+    }
+    std::istringstream moves(arguments["moves"]);
+    std::string text;
+    while (moves >> text) {
+        Move move;
+        if (!parseMove(parsed, text, move)) {
+            error("illegal move " + text);
+            return;
+        }
+        Rules<Geometry>::makeMove(parsed, move);
+    }
+    position = parsed;
+}
+
+template <class Geometry>
+void HubEngine<Geometry>::handleLevel(std::map<std::string, std::string>& arguments) {
+    level = SearchLimits();
+    infinite = arguments.count("infinite") > 0;
+    timeLeft = increment = 0.0;
+    movesToGo = 0;
+    if (arguments.count("depth")) level.depth = std::atoi(arguments["depth"].c_str());
+    if (arguments.count("nodes")) level.nodes = std::strtoull(arguments["nodes"].c_str(), nullptr, 10);
+    if (arguments.count("move-time")) level.timeMs = static_cast<int>(std::atof(arguments["move-time"].c_str()) * 1000.0);
+    if (arguments.count("time")) timeLeft = std::atof(arguments["time"].c_str());
+    if (arguments.count("inc")) increment = std::atof(arguments["inc"].c_str());
+    if (arguments.count("moves")) movesToGo = std::atoi(arguments["moves"].c_str());
+}
+
+template <class Geometry>
+void HubEngine<Geometry>::handleGo(std::map<std::string, std::string>& arguments) {
+    finishSearch();
+    bool analyze = arguments.count("analyze") > 0 || arguments.count("ponder") > 0 || infinite;
+    SearchLimits limits = analyze ? SearchLimits() : level;
+    if (!analyze && !limits.depth && !limits.nodes && !limits.timeMs && timeLeft > 0.0) {
+        // Контроль времени: равная доля остатка на оставшиеся ходы плюс добавка, но не больше половины остатка
+        double budget = timeLeft / (movesToGo > 0 ? movesToGo : 30) + increment;
+        if (budget > timeLeft / 2.0) budget = timeLeft / 2.0;
+        limits.timeMs = static_cast<int>(budget * 1000.0) > 0 ? static_cast<int>(budget * 1000.0) : 1;
+    }
+    stopRequested = false;
+    thinking = true;
+    search.resetStop();            // До запуска потока: stop, пришедший сразу после go, остановит этот поиск
+    searchStart = Clock::now();
+    worker = std::thread(&HubEngine::searchMain, this, position, limits, analyze);
+}
+
+template <class Geometry>
+void HubEngine<Geometry>::requestStop() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        stopRequested = true;
+    }
+    search.stop();
+    stateChanged.notify_all();
+}
+
+template <class Geometry>
+void HubEngine<Geometry>::finishSearch() {
+    if (!worker.joinable()) return;
+    requestStop();
+    worker.join();
+}
+
+//
+// Результат итерации: info с глубиной, оценкой (в шашках), узлами, скоростью и главным вариантом
+//
+template <class Geometry>
+void HubEngine<Geometry>::reportIteration(const SearchInfo& info) {
+    std::ostringstream out;
+    out.setf(std::ios::fixed);
+    out.precision(2);
+    out << "info depth=" << info.depth << " score=" << info.score / 100.0 << " nodes=" << info.nodes
+        << " time=" << info.seconds << " nps=" << static_cast<long long>(info.nodes / (info.seconds > 0.0 ? info.seconds : 1e-9))
+        << " pv=\"";
+    for (size_t i = 0; i < info.pv.size(); i++)
+        out << (i ? " " : "") << moveToHub(info.pv[i]);
+    out << "\"";
+    send(out.str());
+}
+
+//
+// Поток поиска: пока идет поиск, раз в секунду сообщает количество узлов; анализ без ограничений,
+// закончившийся раньше stop (достигнута наибольшая глубина), молча ждет stop перед ответом done
+//
+template <class Geometry>
+void HubEngine<Geometry>::searchMain(PositionType root, SearchLimits limits, bool analyze) {
+    std::thread reporter([this] {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        while (!stateChanged.wait_for(lock, std::chrono::seconds(1), [this] { return !thinking; })) {
+            double seconds = std::chrono::duration<double>(Clock::now() - searchStart).count();
+            uint64_t nodes = search.getNodes();
+            std::ostringstream out;
+            out.setf(std::ios::fixed);
+            out.precision(2);
+            out << "info nodes=" << nodes << " time=" << seconds << " nps=" << static_cast<long long>(nodes / seconds);
+            send(out.str());
+        }
+    });
+
+    SearchInfo info;
+    bool hasMove = search.think(root, limits, info);
+    {
+        std::lock_guard<std::mutex> lock(stateMutex);
+        thinking = false;          // Поиск закончен — ежесекундные сообщения больше не нужны
+    }
+    stateChanged.notify_all();
+    reporter.join();
+    if (analyze) {
+        std::unique_lock<std::mutex> lock(stateMutex);
+        stateChanged.wait(lock, [this] { return stopRequested; });
+    }
+
+    if (!hasMove) {
+        send("done");              // Нет допустимых ходов: партия проиграна
+        return;
+    }
+    std::string line = "done move=" + moveToHub(info.pv[0]);
+    if (info.pv.size() > 1) line += " ponder=" + moveToHub(info.pv[1]);
+    send(line);
+}
+
+template <class Geometry>
+int HubEngine<Geometry>::run() {
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        std::string command;
+        std::map<std::string, std::string> arguments = parseArguments(line, command);
+        if (command.empty()) continue;
+        if (command == "hub") {
+            send("id name=checkers-engine version=1.0");
+            send("param name=weights value=\"\" type=string");
+            send("wait");
+        } else if (command == "init") {
+            send("ready");
+        } else if (command == "ping") {
+            send("pong");
+        } else if (command == "set-param") {
+            finishSearch();
+            if (arguments["name"] != "weights") error("unknown parameter " + arguments["name"]);
+            else if (!arguments["value"].empty() && !evaluator.loadWeights(arguments["value"]))
+                error("cannot load weights " + arguments["value"]);
+        } else if (command == "new-game") {
+            finishSearch();
+            search.clearHistory();
+        } else if (command == "pos") {
+            finishSearch();
+            handlePos(arguments);
+        } else if (command == "level") {
+            handleLevel(arguments);
+        } else if (command == "time") {
+            if (arguments.count("left")) timeLeft = std::atof(arguments["left"].c_str());
+        } else if (command == "go") {
+            handleGo(arguments);
+        } else if (command == "stop") {
+            requestStop();
+        } else if (command == "quit") {
+            break;
+        } else {
+            error("unknown command " + command);
+        }
+    }
+    finishSearch();
+    return 0;
+}
+
+template <class Geometry>
+int runEngine(const char* weightsPath) {
+    HubEngine<Geometry> engine;
+    if (weightsPath && !engine.loadWeights(weightsPath))
+        return 1;
+    return engine.run();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool international = false;
+    const char* weightsPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--10x10") == 0) international = true;
+        else if (std::strcmp(argv[i], "--weights") == 0 && i + 1 < argc) weightsPath = argv[++i];
+        else {
+            std::cerr << "Использование: checkers-engine [--10x10] [--weights файл]" << std::endl;
+            return 1;
+        }
+    }
+    if (international)
+        return runEngine<International10x10>(weightsPath);
+    return runEngine<Russian8x8>(weightsPath);
+}
@@ -0,0 +1,102 @@
+#include "Evaluator.h"             // Подключаем обучаемую оценку позиции
+#include <algorithm>               // Подключаем std::max
+#include <chrono>                  // Подключаем часы для измерения времени
+#include <cmath>                   // Подключаем std::fabs для сравнения результатов ядер
+#include <cstdlib>                 // Подключаем std::atoi
+#include <cstring>                 // Подключаем std::strcmp
+#include <iostream>                // Подключаем вывод результатов
+#include <vector>                  // Подключаем std::vector для пакета позиций
+
+//
+// Бенчмарк пакетной оценки: сравнивает скорость скалярного и SIMD-ядер на одном ядре процессора.
+// Использование: eval-bench [--10x10] [--weights файл] [--positions N]
+//
+
+namespace {
+
+// Простой детерминированный генератор случайных чисел, чтобы результаты повторялись от запуска к запуску
+uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+// Случайная позиция: каждая клетка пуста с вероятностью 1/2, иначе на ней случайная фигура
+template <class Geometry>
+Position<Geometry> randomPosition(uint32_t& state) {
+    Position<Geometry> position;
+    for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+        uint32_t r = nextRandom(state) % 8;
+        position.squares[sq] = static_cast<int8_t>(r < 4 ? 0 : r - 3); // Коды 1..4 — фигуры, 0 — пустая клетка
+    }
+    position.sideToMove = (nextRandom(state) & 1) ? white_checker : black_checker;
+    return position;
+}
+
+template <class Geometry>
+int runBenchmark(const char* weightsPath, int positionCount) {
+    typedef Evaluator<Geometry> EvaluatorType;
+    EvaluatorType evaluator;
+    if (weightsPath && !evaluator.loadWeights(weightsPath))
+        return 1;
+
+    uint32_t state = 12345;
+    std::vector<Position<Geometry> > positions;
+    for (int i = 0; i < positionCount; i++)
+        positions.push_back(randomPosition<Geometry>(state));
+
+    std::vector<float> reference(positionCount);             // Результаты скалярного ядра для проверки SIMD-ядер
+    std::vector<float> scores(positionCount);
+    double scalarRate = 0.0;
+
+    const typename EvaluatorType::Kernel kernels[] = { EvaluatorType::kernel_scalar, EvaluatorType::kernel_sse41,
+                                                       EvaluatorType::kernel_avx2 };
+    const typename EvaluatorType::Kernel best = EvaluatorType::bestKernel();
+    std::cout << "Доска " << Geometry::SIZE << "x" << Geometry::SIZE << ", позиций в пакете: " << positionCount
+              << ", лучшее ядро: " << EvaluatorType::kernelName(best) << std::endl;
+
+    for (int k = 0; k < 3; k++) {
+        if (kernels[k] > best) break;                            // Ядра упорядочены по требованиям к процессору
+        evaluator.setKernel(kernels[k]);
+
+        long long evaluations = 0;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        double elapsed = 0.0;
+        do {                                                     // Оцениваем пакеты не меньше секунды
+            evaluator.evaluateBatch(&positions[0], positionCount, &scores[0]);
+            evaluations += positionCount;
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 1.0);
+
+        double rate = evaluations / elapsed;                     // Оценок в секунду на одном ядре
+        if (k == 0) {
+            scalarRate = rate;
+            reference = scores;
+        }
+        double maxError = 0.0;                                   // Максимальное расхождение со скалярным ядром
+        for (int i = 0; i < positionCount; i++)
+            maxError = std::max(maxError, static_cast<double>(std::fabs(scores[i] - reference[i])));
+
+        std::cout << "  " << EvaluatorType::kernelName(kernels[k]) << ": "
+                  << static_cast<long long>(rate) << " оценок/с на ядро, ускорение x" << rate / scalarRate
+                  << ", расхождение со скалярным " << maxError << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool international = false;    // По умолчанию измеряем доску 8x8
+    const char* weightsPath = nullptr;
+    int positionCount = 4096;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--10x10") == 0) international = true;
+        else if (std::strcmp(argv[i], "--weights") == 0 && i + 1 < argc) weightsPath = argv[++i];
+        else if (std::strcmp(argv[i], "--positions") == 0 && i + 1 < argc) positionCount = std::atoi(argv[++i]);
+    }
+    if (positionCount <= 0) positionCount = 4096;
+
+    if (international)
+        return runBenchmark<International10x10>(weightsPath, positionCount);
+    return runBenchmark<Russian8x8>(weightsPath, positionCount);
+}
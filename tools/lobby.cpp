@@ -0,0 +1,271 @@
+#include "Board.h"                 // Подключаем константы сторон white_checker и black_checker
+#include "Matchmaker.h"            // Подключаем подбор соперников
+#include "NetworkManager.h"        // Подключаем формат запроса на подбор (MATCH_REQUEST)
+#include <SDL2/SDL_net.h>          // Подключаем SDL_net для работы с сокетами
+#include <cstdlib>                 // Подключаем std::atoi
+#include <cstring>                 // Подключаем std::strcmp
+#include <iostream>                // Подключаем вывод сообщений
+#include <map>                     // Подключаем таблицы подключенных и ожидающих игроков
+#include <vector>                  // Подключаем std::vector
+
+//
+// checkers-lobby: сервер подбора соперников. Клиенты (режим 4 игры) подключаются к порту 12345 и присылают
+// размер доски и рейтинг. Все сокеты обслуживает один сетевой поток: он принимает подключения, ставит
+// заявки в очередь подбора, отправляет игрокам назначенные стороны и пересылает ходы всех партий в одном
+// цикле SDLNet_CheckSockets. Поток подбора только соединяет заявки одного варианта с близким рейтингом
+// и передает пары сетевому потоку через очередь без блокировок, поэтому медленный клиент не задерживает подбор.
+// Чтение не блокирует цикл: сокет читается, только когда готов, а запрос, пришедший по частям, собирается
+// в буфере клиента. Отправка же блокирующая (SDLNet_TCP_Send): если соперник не читает ходы и буфер его
+// сокета заполнен, сетевой поток ждет, и пересылка во всех партиях останавливается до тех пор.
+//
+// Использование: checkers-lobby [--port N] [--window начальное рост предел]
+//
+
+namespace {
+
+const int MAX_CLIENTS = 1024;      // Сколько подключений одновременно обслуживает сервер (ожидающие и играющие)
+const int RELAY_BUFFER = 64;       // Размер буфера пересылки
+const Uint32 POLL_MS = 10;         // Наибольшее ожидание активности сокетов за один проход цикла
+
+// Состояние подключения
+enum ClientState {
+    client_pending,                // Подключился, запрос на подбор еще не получен
+    client_waiting,                // Заявка в очереди подбора
+    client_playing                 // Играет партию, ходы пересылаются сопернику
+};
+
+// Подключенный клиент
+struct Client {
+    ClientState state;             // Состояние подключения
+    uint8_t request[MATCH_REQUEST_SIZE]; // Запрос на подбор (может прийти по частям)
+    int requestBytes;              // Сколько байт запроса уже получено
+    uint32_t playerId;             // Идентификатор игрока в очереди подбора
+    TCPsocket peer;                // Сокет соперника (только client_playing)
+    uint32_t gameId;               // Идентификатор партии (только client_playing)
+};
+
+//
+// Сервер подбора: все сокеты принадлежат сетевому потоку (run), поток подбора только создает пары
+//
+class Lobby {
+public:
+    Lobby(TCPsocket server, const Matchmaker::Window& window)
+        : server(server), socketSet(SDLNet_AllocSocketSet(MAX_CLIENTS + 1)), pairings(MAX_CLIENTS),
+          matchmaker(MAX_CLIENTS, window, [this](const Pairing& pairing) {
+              if (!pairings.tryPush(pairing)) // Пар не больше, чем ожидающих игроков, поэтому очередь не переполняется
+                  std::cout << "Очередь пар заполнена, партия " << pairing.gameId << " потеряна" << std::endl;
+          }),
+          nextPlayerId(1)
+    {
+        SDLNet_TCP_AddSocket(socketSet, server); // Серверный сокет готов к чтению, когда есть новое подключение
+    }
+
+    ~Lobby() {
+        matchmaker.stop();
+        while (!clients.empty())
+            drop(clients.begin()->first);
+        SDLNet_FreeSocketSet(socketSet);
+    }
+
+    void run() {
+        matchmaker.start();
+        while (true) {
+            int ready = SDLNet_CheckSockets(socketSet, POLL_MS);
+            if (ready > 0) {
+                if (SDLNet_SocketReady(server)) acceptClients();
+                serveClients();    // До создания партий: отключившиеся игроки удаляются раньше, чем получат соперника
+            }
+            startGames();
+        }
+    }
+
+private:
+    void acceptClients();          // Прием новых подключений
+    void serveClients();           // Чтение со всех готовых сокетов
+    void readRequest(TCPsocket socket, Client& client); // Чтение запроса на подбор от нового клиента (по частям)
+    void relay(TCPsocket socket, Client& client); // Пересылка данных сопернику
+    void startGames();             // Начало партий для пар, созданных потоком подбора
+    void keepWaiting(const MatchTicket& ticket); // Возврат живого игрока в очередь, если соперник отключился
+    void drop(TCPsocket socket);   // Закрытие подключения (заявка в пуле отменяется)
+
+    TCPsocket server;              // Серверный сокет
+    SDLNet_SocketSet socketSet;    // Все сокеты: серверный и клиентские
+    std::map<TCPsocket, Client> clients; // Подключенные клиенты
+    std::map<uint32_t, TCPsocket> waiting; // Игроки в очереди подбора по идентификатору
+    MpmcQueue<Pairing> pairings;   // Пары от потока подбора
+    Matchmaker matchmaker;         // Подбор соперников
+    uint32_t nextPlayerId;         // Идентификатор следующего игрока
+};
+
+void Lobby::acceptClients() {
+    TCPsocket socket;
+    while ((socket = SDLNet_TCP_Accept(server))) {
+        if (static_cast<int>(clients.size()) >= MAX_CLIENTS) {
+            SDLNet_TCP_Close(socket);  // Сервер заполнен — новое подключение отклоняем
+            continue;
+        }
+        Client client = Client();
+        client.state = client_pending;
+        clients[socket] = client;
+        SDLNet_TCP_AddSocket(socketSet, socket);
+    }
+}
+
+//
+// Обработка готовых сокетов. Сокет ожидающего игрока готов к чтению, только если игрок отключился
+// (клиент ничего не присылает до назначения стороны), поэтому такая заявка сразу отменяется
+//
+void Lobby::serveClients() {
+    std::vector<TCPsocket> ready;  // Список собирается заранее: обработка одного сокета может закрыть другой
+    for (std::map<TCPsocket, Client>::iterator it = clients.begin(); it != clients.end(); ++it)
+        if (SDLNet_SocketReady(it->first)) ready.push_back(it->first);
+
+    for (size_t i = 0; i < ready.size(); i++) {
+        std::map<TCPsocket, Client>::iterator it = clients.find(ready[i]);
+        if (it == clients.end()) continue; // Уже закрыт вместе с соперником
+        switch (it->second.state) {
+            case client_pending: readRequest(it->first, it->second); break;
+            case client_waiting: drop(it->first); break;
+            case client_playing: relay(it->first, it->second); break;
+        }
+    }
+}
+
+//
+// Чтение запроса на подбор. Сокет готов к чтению, поэтому SDLNet_TCP_Recv возвращает то, что уже пришло,
+// и не ждет остальное; запрос проверяется, когда получены все MATCH_REQUEST_SIZE байт
+//
+void Lobby::readRequest(TCPsocket socket, Client& client) {
+    int received = SDLNet_TCP_Recv(socket, client.request + client.requestBytes, MATCH_REQUEST_SIZE - client.requestBytes);
+    if (received <= 0) {
+        drop(socket);              // Клиент отключился, не договорив запрос
+        return;
+    }
+    client.requestBytes += received;
+    if (client.requestBytes < MATCH_REQUEST_SIZE)
+        return;                    // Остаток запроса придет со следующими сегментами
+
+    const uint8_t* request = client.request;
+    bool valid = (request[0] == MATCH_REQUEST &&
+                  (request[1] == Russian8x8::SIZE || request[1] == International10x10::SIZE));
+    if (!valid) {
+        drop(socket);              // Неверный запрос или неизвестный вариант игры
+        return;
+    }
+    client.playerId = nextPlayerId++;
+    if (!matchmaker.enqueue(client.playerId, request[1], (request[2] << 8) | request[3], socket)) {
+        drop(socket);              // Очередь подбора заполнена
+        return;
+    }
+    client.state = client_waiting;
+    waiting[client.playerId] = socket;
+}
+
+void Lobby::relay(TCPsocket socket, Client& client) {
+    uint8_t buffer[RELAY_BUFFER];
+    int received = SDLNet_TCP_Recv(socket, buffer, RELAY_BUFFER);
+    if (received > 0 && SDLNet_TCP_Send(client.peer, buffer, received) == received)
+        return;
+    std::cout << "Партия " << client.gameId << " завершена" << std::endl;
+    drop(socket);                  // Один из игроков отключился — партия окончена, закрываем обоих
+}
+
+//
+// Начало партий: стороны отправляются здесь, в сетевом потоке, а не в потоке подбора.
+// Если один из игроков успел отключиться, второй возвращается в очередь с прежним временем ожидания
+//
+void Lobby::startGames() {
+    Pairing pairing;
+    while (pairings.tryPop(pairing)) {
+        std::map<uint32_t, TCPsocket>::iterator white = waiting.find(pairing.white.playerId);
+        std::map<uint32_t, TCPsocket>::iterator black = waiting.find(pairing.black.playerId);
+        if (white == waiting.end() || black == waiting.end()) {
+            if (white != waiting.end()) keepWaiting(pairing.white);
+            if (black != waiting.end()) keepWaiting(pairing.black);
+            continue;
+        }
+        TCPsocket whiteSocket = white->second;
+        TCPsocket blackSocket = black->second;
+        waiting.erase(white);
+        waiting.erase(black);
+
+        uint8_t whiteSide = white_checker;
+        uint8_t blackSide = black_checker;
+        if (SDLNet_TCP_Send(whiteSocket, &whiteSide, 1) < 1 || SDLNet_TCP_Send(blackSocket, &blackSide, 1) < 1) {
+            std::cout << "Партия " << pairing.gameId << " не начата: игрок отключился" << std::endl;
+            drop(whiteSocket);
+            drop(blackSocket);
+            continue;
+        }
+        Client& whiteClient = clients[whiteSocket];
+        Client& blackClient = clients[blackSocket];
+        whiteClient.state = blackClient.state = client_playing;
+        whiteClient.peer = blackSocket;
+        blackClient.peer = whiteSocket;
+        whiteClient.gameId = blackClient.gameId = pairing.gameId;
+        std::cout << "Партия " << pairing.gameId << " (" << pairing.white.variant << "x" << pairing.white.variant
+                  << "): игрок " << pairing.white.playerId << " (" << pairing.white.rating << ") белыми, игрок "
+                  << pairing.black.playerId << " (" << pairing.black.rating << ") черными, ожидание "
+                  << std::chrono::duration<double, std::milli>(pairing.matched - pairing.white.enqueued).count() << " мс"
+                  << std::endl;
+    }
+}
+
+void Lobby::keepWaiting(const MatchTicket& ticket) {
+    if (!matchmaker.requeue(ticket))
+        drop(waiting[ticket.playerId]); // Очередь подбора заполнена — игроку придется подключиться заново
+}
+
+void Lobby::drop(TCPsocket socket) {
+    std::map<TCPsocket, Client>::iterator it = clients.find(socket);
+    if (it == clients.end()) return;
+    Client client = it->second;
+    clients.erase(it);
+    if (client.state == client_waiting) {
+        waiting.erase(client.playerId);
+        matchmaker.cancel(client.playerId); // Отключившийся игрок не должен получить соперника
+    }
+    SDLNet_TCP_DelSocket(socketSet, socket);
+    SDLNet_TCP_Close(socket);
+    if (client.state == client_playing)
+        drop(client.peer);         // Соперник остается без партии — закрываем и его
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int port = 12345;              // Порт, к которому подключаются клиенты
+    Matchmaker::Window window = { 50, 25, 400 }; // Окно рейтинга: 50, +25 в секунду, не больше 400
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--port") == 0 && i + 1 < argc) port = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--window") == 0 && i + 3 < argc) {
+            window.initial = std::atoi(argv[++i]);
+            window.growthPerSecond = std::atoi(argv[++i]);
+            window.maximum = std::atoi(argv[++i]);
+        } else {
+            std::cout << "Использование: checkers-lobby [--port N] [--window начальное рост предел]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (SDLNet_Init() < 0) {
+        std::cout << "SDLNet ошибка: " << SDLNet_GetError() << std::endl;
+        return 1;
+    }
+    IPaddress ip;
+    if (SDLNet_ResolveHost(&ip, NULL, static_cast<Uint16>(port)) < 0) {
+        std::cout << "Ошибка разрешения хоста: " << SDLNet_GetError() << std::endl;
+        return 1;
+    }
+    TCPsocket server = SDLNet_TCP_Open(&ip);
+    if (!server) {
+        std::cout << "Не удалось открыть серверный сокет: " << SDLNet_GetError() << std::endl;
+        return 1;
+    }
+
+    Lobby lobby(server, window);
+    std::cout << "Сервер подбора ожидает игроков на порту " << port << std::endl;
+    lobby.run();
+    return 0;
+}
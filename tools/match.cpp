@@ -0,0 +1,316 @@
+#include "Search.h"                // Подключаем поиск лучшего хода
+#include <algorithm>               // Подключаем std::shuffle и std::min
+#include <atomic>                  // Подключаем атомарные счетчики партий
+#include <chrono>                  // Подключаем часы для измерения времени матча
+#include <cmath>                   // Подключаем std::log, std::log10, std::pow, std::sqrt
+#include <cstdlib>                 // Подключаем std::atoi и std::atof
+#include <cstring>                 // Подключаем std::strcmp
+#include <iostream>                // Подключаем вывод результатов
+#include <map>                     // Подключаем учет повторений позиций
+#include <memory>                  // Подключаем std::unique_ptr
+#include <mutex>                   // Подключаем мьютекс общей статистики
+#include <random>                  // Подключаем перемешивание дебютов
+#include <set>                     // Подключаем удаление одинаковых дебютных позиций
+#include <string>                  // Подключаем ключи позиций
+#include <thread>                  // Подключаем потоки, играющие партии
+#include <vector>                  // Подключаем std::vector
+
+//
+// checkers-match: матч двух версий движка (разные веса оценки и/или ограничения поиска). Партии играются
+// параллельно на всех ядрах; каждый дебют играется дважды со сменой цвета. Дебюты — все позиции после
+// нескольких первых полуходов из начальной расстановки Board::initBoard, оценка которых близка к равенству.
+// После каждой партии пересчитываются Elo с 95% доверительным интервалом и отношение правдоподобия SPRT;
+// матч останавливается, как только тест принимает одну из гипотез.
+//
+// Использование: checkers-match [--10x10] [--weights1 файл] [--weights2 файл] [--games N] [--threads N]
+//                               [--nodes N] [--time мс] [--depth N] [--nodes2 N] [--time2 мс] [--depth2 N]
+//                               [--opening-plies N] [--max-plies N] [--sprt elo0 elo1 alpha beta]
+//
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Параметры матча
+struct MatchOptions {
+    const char* weights[2];        // Веса оценки движков (nullptr — веса по умолчанию)
+    SearchLimits limits[2];        // Ограничения поиска движков
+    int games;                     // Наибольшее количество партий
+    int threads;                   // Количество потоков
+    int openingPlies;              // Глубина дебютов в полуходах
+    int maxPlies;                  // Партия длиннее этого признается ничьей
+    double elo0, elo1;             // Гипотезы SPRT: H0 — разница elo0, H1 — разница elo1
+    double alpha, beta;            // Вероятности ошибок первого и второго рода
+};
+
+// Итоги матча с точки зрения первого движка
+struct MatchStats {
+    long long wins, draws, losses; // Победы, ничьи, поражения первого движка
+    long long nodes[2];            // Узлов поиска каждого движка
+    double seconds[2];             // Время поиска каждого движка
+    long long searches[2];         // Количество поисков (ходов) каждого движка
+    long long depth[2];            // Сумма глубин поиска
+};
+
+double scoreToElo(double score) {
+    score = std::min(std::max(score, 1e-6), 1.0 - 1e-6);
+    return -400.0 * std::log10(1.0 / score - 1.0) + 0.0; // + 0.0 убирает «-0» при равном счете
+}
+
+double eloToScore(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+// Средний результат и его дисперсия на одну партию
+void scoreMoments(const MatchStats& stats, double& score, double& variance) {
+    double n = static_cast<double>(stats.wins + stats.draws + stats.losses);
+    score = (stats.wins + 0.5 * stats.draws) / n;
+    variance = (stats.wins * (1.0 - score) * (1.0 - score) + stats.draws * (0.5 - score) * (0.5 - score) +
+                stats.losses * score * score) / n;
+}
+
+//
+// Логарифм отношения правдоподобия SPRT в нормальном приближении (как в тестовых системах шахматных движков)
+//
+double sprtLlr(const MatchStats& stats, double elo0, double elo1) {
+    long long n = stats.wins + stats.draws + stats.losses;
+    if (n < 2) return 0.0;
+    double score, variance;
+    scoreMoments(stats, score, variance);
+    if (variance <= 0.0) return 0.0;
+    double s0 = eloToScore(elo0), s1 = eloToScore(elo1);
+    return n * (s1 - s0) * (2.0 * score - s0 - s1) / (2.0 * variance);
+}
+
+//
+// Дебюты: все позиции после openingPlies полуходов от начальной расстановки, без повторов,
+// с оценкой неглубокого поиска не больше balance по модулю (примерно половина шашки)
+//
+template <class Geometry>
+std::vector<Position<Geometry> > buildOpenings(int openingPlies, const Evaluator<Geometry>& evaluator, int balance) {
+    typedef Position<Geometry> PositionType;
+    Board<Geometry> board(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr); // Поле без текстур
+    board.initBoard();
+    std::vector<PositionType> frontier(1, PositionType::fromBoard(board, white_checker));
+
+    for (int ply = 0; ply < openingPlies; ply++) {
+        std::vector<PositionType> next;
+        std::set<std::string> seen;
+        for (size_t i = 0; i < frontier.size(); i++) {
+            Move moves[MAX_MOVES];
+            int count = Rules<Geometry>::generateMoves(frontier[i], moves);
+            for (int m = 0; m < count; m++) {
+                PositionType child = frontier[i];
+                Rules<Geometry>::makeMove(child, moves[m]);
+                std::string key(reinterpret_cast<const char*>(child.squares), Geometry::SQUARES);
+                if (seen.insert(key).second) next.push_back(child);
+            }
+        }
+        frontier.swap(next);
+    }
+
+    std::vector<PositionType> openings;
+    Search<Geometry> search(evaluator);
+    SearchLimits limits;
+    limits.depth = 6;
+    for (size_t i = 0; i < frontier.size(); i++) {
+        SearchInfo info;
+        if (search.think(frontier[i], limits, info) && std::abs(info.score) <= balance)
+            openings.push_back(frontier[i]);
+    }
+    std::mt19937 random(2024);     // Перемешиваем, чтобы при ранней остановке дебюты были разнообразными
+    std::shuffle(openings.begin(), openings.end(), random);
+    return openings;
+}
+
+//
+// Одна партия. engines[0] играет белыми; возвращает результат белых (1, 0.5 или 0)
+//
+template <class Geometry>
+double playGame(Position<Geometry> position, Search<Geometry>* engines[2], const SearchLimits* limits[2],
+                int maxPlies, MatchStats& local, const int engineIndex[2]) {
+    std::map<std::string, int> repetitions; // Трехкратное повторение позиции — ничья
+    for (int ply = 0; ply < maxPlies; ply++) {
+        int side = (position.sideToMove == white_checker) ? 0 : 1;
+        std::string key(reinterpret_cast<const char*>(position.squares), Geometry::SQUARES);
+        key += static_cast<char>(side);
+        if (++repetitions[key] >= 3)
+            return 0.5;
+
+        SearchInfo info;
+        if (!engines[side]->think(position, *limits[side], info))
+            return side == 0 ? 0.0 : 1.0; // Нет ходов — поражение стороны, которая ходит
+        int engine = engineIndex[side];
+        local.nodes[engine] += static_cast<long long>(info.nodes);
+        local.seconds[engine] += info.seconds;
+        local.searches[engine]++;
+        local.depth[engine] += info.depth;
+        Rules<Geometry>::makeMove(position, info.pv[0]);
+    }
+    return 0.5;                    // Слишком длинная партия — ничья
+}
+
+void printStats(const MatchStats& stats, const MatchOptions& options, double elapsed) {
+    long long n = stats.wins + stats.draws + stats.losses;
+    if (n == 0) {                  // Ни одной сыгранной партии — Elo и LLR не определены
+        std::cout << "Партий: 0" << std::endl;
+        return;
+    }
+    double score, variance;
+    scoreMoments(stats, score, variance);
+    double margin = 1.96 * std::sqrt(variance / n);
+    double elo = scoreToElo(score);
+    double low = scoreToElo(score - margin), high = scoreToElo(score + margin);
+    std::cout << "Партий: " << n << " (+" << stats.wins << " =" << stats.draws << " -" << stats.losses << "), Elo "
+              << elo << " [" << low << ", " << high << "], LLR " << sprtLlr(stats, options.elo0, options.elo1)
+              << " [" << std::log(options.beta / (1.0 - options.alpha)) << ", "
+              << std::log((1.0 - options.beta) / options.alpha) << "], " << n / elapsed << " партий/с" << std::endl;
+}
+
+template <class Geometry>
+int runMatch(const MatchOptions& options) {
+    Evaluator<Geometry> evaluators[2];
+    for (int e = 0; e < 2; e++)
+        if (options.weights[e] && !evaluators[e].loadWeights(options.weights[e]))
+            return 1;
+
+    std::vector<Position<Geometry> > openings = buildOpenings<Geometry>(options.openingPlies, evaluators[0], 50);
+    if (openings.empty()) {
+        std::cout << "Нет сбалансированных дебютов" << std::endl;
+        return 1;
+    }
+    std::cout << "Дебютов: " << openings.size() << " (каждый играется обоими цветами), потоков: " << options.threads
+              << ", ядро оценки: " << Evaluator<Geometry>::kernelName(evaluators[0].getKernel()) << std::endl;
+
+    const double lower = std::log(options.beta / (1.0 - options.alpha)); // Граница принятия H0
+    const double upper = std::log((1.0 - options.beta) / options.alpha); // Граница принятия H1
+    MatchStats stats = MatchStats();
+    std::mutex statsMutex;
+    std::atomic<int> nextGame(0);
+    std::atomic<bool> decided(false);
+    int verdict = 0;               // Решение SPRT на момент остановки: 1 — H1, -1 — H0, 0 — не принято
+    double verdictLlr = 0.0;       // LLR, при котором принято решение
+    long long verdictGames = 0;    // Сколько партий было сыграно к решению
+    Clock::time_point start = Clock::now();
+
+    // Каждый поток берет следующую партию из общего счетчика; партии 2k и 2k+1 — один дебют с разными цветами
+    std::vector<std::thread> workers;
+    for (int t = 0; t < options.threads; t++) {
+        workers.push_back(std::thread([&] {
+            std::unique_ptr<Search<Geometry> > searches[2] = {
+                std::unique_ptr<Search<Geometry> >(new Search<Geometry>(evaluators[0])),
+                std::unique_ptr<Search<Geometry> >(new Search<Geometry>(evaluators[1]))
+            };
+            while (!decided.load()) {
+                int game = nextGame.fetch_add(1);
+                if (game >= options.games) break;
+                const Position<Geometry>& opening = openings[(game / 2) % openings.size()];
+                int firstIsWhite = (game % 2 == 0);
+                int engineIndex[2] = { firstIsWhite ? 0 : 1, firstIsWhite ? 1 : 0 }; // Движок белых и черных
+                Search<Geometry>* engines[2] = { searches[engineIndex[0]].get(), searches[engineIndex[1]].get() };
+                const SearchLimits* limits[2] = { &options.limits[engineIndex[0]], &options.limits[engineIndex[1]] };
+                engines[0]->clearHistory();
+                engines[1]->clearHistory();
+
+                MatchStats local = MatchStats();
+                double whiteScore = playGame<Geometry>(opening, engines, limits, options.maxPlies, local, engineIndex);
+                double firstScore = firstIsWhite ? whiteScore : 1.0 - whiteScore;
+
+                std::lock_guard<std::mutex> lock(statsMutex);
+                if (firstScore == 1.0) stats.wins++;
+                else if (firstScore == 0.0) stats.losses++;
+                else stats.draws++;
+                for (int e = 0; e < 2; e++) {
+                    stats.nodes[e] += local.nodes[e];
+                    stats.seconds[e] += local.seconds[e];
+                    stats.searches[e] += local.searches[e];
+                    stats.depth[e] += local.depth[e];
+                }
+                long long played = stats.wins + stats.draws + stats.losses;
+                double llr = sprtLlr(stats, options.elo0, options.elo1);
+                if (!decided && (llr <= lower || llr >= upper)) {
+                    decided = true; // Тест принял решение — новые партии не начинаются
+                    verdict = llr >= upper ? 1 : -1; // Партии, доигранные другими потоками, решение не меняют
+                    verdictLlr = llr;
+                    verdictGames = played;
+                }
+                if (played % 100 == 0)
+                    printStats(stats, options, std::chrono::duration<double>(Clock::now() - start).count());
+            }
+        }));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    std::cout << "Итог за " << elapsed << " с:" << std::endl;
+    printStats(stats, options, elapsed);
+    for (int e = 0; e < 2; e++) {
+        double searches = stats.searches[e] ? static_cast<double>(stats.searches[e]) : 1.0;
+        std::cout << "Движок " << e + 1 << ": " << static_cast<long long>(stats.nodes[e] / std::max(stats.seconds[e], 1e-9))
+                  << " узлов/с, средняя глубина " << stats.depth[e] / searches
+                  << ", узлов на ход " << static_cast<long long>(stats.nodes[e] / searches) << std::endl;
+    }
+    if (verdict == 1)
+        std::cout << "SPRT: принята H1 — движок 1 сильнее на " << options.elo1 << " Elo или больше";
+    else if (verdict == -1)
+        std::cout << "SPRT: принята H0 — движок 1 не сильнее чем на " << options.elo0 << " Elo";
+    else
+        std::cout << "SPRT: решение не принято, нужно больше партий";
+    if (verdict != 0)
+        std::cout << " (LLR " << verdictLlr << " после " << verdictGames << " партий)";
+    std::cout << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    MatchOptions options;
+    options.weights[0] = options.weights[1] = nullptr;
+    options.games = 20000;
+    options.threads = static_cast<int>(std::thread::hardware_concurrency());
+    options.openingPlies = 3;
+    options.maxPlies = 200;
+    options.elo0 = 0.0;
+    options.elo1 = 10.0;
+    options.alpha = options.beta = 0.05;
+    bool international = false;
+    bool secondLimits = false;     // Ограничения второго движка заданы отдельно
+    SearchLimits second;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--10x10") == 0) international = true;
+        else if (std::strcmp(argv[i], "--weights1") == 0 && i + 1 < argc) options.weights[0] = argv[++i];
+        else if (std::strcmp(argv[i], "--weights2") == 0 && i + 1 < argc) options.weights[1] = argv[++i];
+        else if (std::strcmp(argv[i], "--games") == 0 && i + 1 < argc) options.games = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--nodes") == 0 && i + 1 < argc) options.limits[0].nodes = std::atoll(argv[++i]);
+        else if (std::strcmp(argv[i], "--time") == 0 && i + 1 < argc) options.limits[0].timeMs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) options.limits[0].depth = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--nodes2") == 0 && i + 1 < argc) { second.nodes = std::atoll(argv[++i]); secondLimits = true; }
+        else if (std::strcmp(argv[i], "--time2") == 0 && i + 1 < argc) { second.timeMs = std::atoi(argv[++i]); secondLimits = true; }
+        else if (std::strcmp(argv[i], "--depth2") == 0 && i + 1 < argc) { second.depth = std::atoi(argv[++i]); secondLimits = true; }
+        else if (std::strcmp(argv[i], "--opening-plies") == 0 && i + 1 < argc) options.openingPlies = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-plies") == 0 && i + 1 < argc) options.maxPlies = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--sprt") == 0 && i + 4 < argc) {
+            options.elo0 = std::atof(argv[++i]);
+            options.elo1 = std::atof(argv[++i]);
+            options.alpha = std::atof(argv[++i]);
+            options.beta = std::atof(argv[++i]);
+        } else {
+            std::cout << "Использование: checkers-match [--10x10] [--weights1 файл] [--weights2 файл] [--games N]"
+                         " [--threads N] [--nodes N] [--time мс] [--depth N] [--nodes2 N] [--time2 мс] [--depth2 N]"
+                         " [--opening-plies N] [--max-plies N] [--sprt elo0 elo1 alpha beta]" << std::endl;
+            return 1;
+        }
+    }
+    if (!options.limits[0].nodes && !options.limits[0].timeMs && !options.limits[0].depth)
+        options.limits[0].nodes = 20000; // По умолчанию — фиксированное число узлов (результат не зависит от загрузки машины)
+    options.limits[1] = secondLimits ? second : options.limits[0];
+    if (options.threads <= 0) options.threads = 1;
+
+    if (international)
+        return runMatch<International10x10>(options);
+    return runMatch<Russian8x8>(options);
+}
@@ -0,0 +1,123 @@
+#include "BoardGeometry.h"         // Подключаем размер доски, который служит вариантом игры в заявке
+#include "Matchmaker.h"            // Подключаем подбор соперников
+#include <algorithm>               // Подключаем std::sort и std::min
+#include <atomic>                  // Подключаем атомарные счетчики
+#include <cstdlib>                 // Подключаем std::atoi
+#include <cstring>                 // Подключаем std::strcmp
+#include <iostream>                // Подключаем вывод результатов
+#include <random>                  // Подключаем генератор рейтингов
+#include <thread>                  // Подключаем потоки-производители
+#include <vector>                  // Подключаем std::vector
+
+//
+// match-bench: синтетическая нагрузка на подбор соперников. Несколько потоков (как потоки приема соединений)
+// ставят в очередь игроков со случайным рейтингом — все сразу («наплыв входов») или с заданной частотой;
+// измеряются пары в секунду и время ожидания игроков в очереди.
+//
+// Использование: match-bench [--players N] [--producers N] [--rate игроков/с] [--window начальное рост предел]
+//
+
+namespace {
+
+double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) return 0.0;
+    size_t index = std::min(sorted.size() - 1, static_cast<size_t>(fraction * sorted.size()));
+    return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int players = 200000;          // Всего игроков
+    int producers = 4;             // Потоков, ставящих заявки
+    int rate = 0;                  // Игроков в секунду (0 — все сразу)
+    Matchmaker::Window window = { 50, 100, 400 }; // Окно рейтинга: 50, +100 в секунду, не больше 400
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--players") == 0 && i + 1 < argc) players = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--producers") == 0 && i + 1 < argc) producers = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) rate = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--window") == 0 && i + 3 < argc) {
+            window.initial = std::atoi(argv[++i]);
+            window.growthPerSecond = std::atoi(argv[++i]);
+            window.maximum = std::atoi(argv[++i]);
+        } else {
+            std::cout << "Использование: match-bench [--players N] [--producers N] [--rate игроков/с]"
+                         " [--window начальное рост предел]" << std::endl;
+            return 1;
+        }
+    }
+    if (producers <= 0) producers = 1;
+
+    // Обработчик вызывается только в потоке подбора, поэтому вектор времен ожидания не нужно защищать
+    std::vector<double> waits;
+    waits.reserve(players);
+    double ratingGap = 0.0;
+    MatchClock::time_point lastMatch = MatchClock::now();
+    Matchmaker matchmaker(4096, window, [&](const Pairing& pairing) {
+        waits.push_back(std::chrono::duration<double, std::milli>(pairing.matched - pairing.white.enqueued).count());
+        waits.push_back(std::chrono::duration<double, std::milli>(pairing.matched - pairing.black.enqueued).count());
+        ratingGap += std::abs(pairing.white.rating - pairing.black.rating);
+        lastMatch = pairing.matched;
+    });
+    matchmaker.start();
+
+    std::atomic<long long> fullRetries(0); // Сколько раз очередь оказалась заполнена
+    MatchClock::time_point start = MatchClock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; p++) {
+        threads.push_back(std::thread([&, p] {
+            std::mt19937 random(12345 + p);
+            std::normal_distribution<double> ratings(1500.0, 300.0);
+            int count = players / producers + (p < players % producers ? 1 : 0);
+            for (int i = 0; i < count; i++) {
+                if (rate > 0) {    // Равномерная нагрузка: заявка не раньше своего времени
+                    MatchClock::time_point due = start + std::chrono::microseconds(
+                        static_cast<long long>((static_cast<double>(i) * producers + p) * 1e6 / rate));
+                    std::this_thread::sleep_until(due);
+                }
+                uint32_t id = static_cast<uint32_t>(i * producers + p);
+                int rating = static_cast<int>(ratings(random));
+                while (!matchmaker.enqueue(id, Russian8x8::SIZE, rating, nullptr)) {
+                    fullRetries++;
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    double enqueueSeconds = std::chrono::duration<double>(MatchClock::now() - start).count();
+
+    // Ждем, пока все заявки не попадут в пул и окна не расширятся до предела без новых пар:
+    // оставшимся игрокам (нечетный или с крайним рейтингом) соперника уже не найти
+    double windowSeconds = window.growthPerSecond > 0
+        ? std::max(0.0, static_cast<double>(window.maximum - window.initial) / window.growthPerSecond) : 0.0;
+    MatchClock::time_point deadline = MatchClock::now() + std::chrono::seconds(30);
+    MatchClock::time_point progress = MatchClock::now();
+    uint64_t seen = 0;
+    while (MatchClock::now() < deadline) {
+        uint64_t current = matchmaker.getPairings();
+        if (current != seen) {
+            seen = current;
+            progress = MatchClock::now();
+        } else if (current * 2 + matchmaker.getWaiting() >= static_cast<uint64_t>(players) &&
+                   std::chrono::duration<double>(MatchClock::now() - progress).count() > windowSeconds + 0.1) {
+            break;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    matchmaker.stop();
+    double seconds = std::chrono::duration<double>(lastMatch - start).count(); // Время до последней созданной пары
+
+    uint64_t pairs = matchmaker.getPairings();
+    std::sort(waits.begin(), waits.end());
+    std::cout << "Игроков: " << players << ", потоков: " << producers
+              << ", постановка в очередь: " << enqueueSeconds << " с, очередь заполнена: " << fullRetries.load() << " раз" << std::endl;
+    std::cout << "Пар: " << pairs << " за " << seconds << " с — " << static_cast<long long>(seconds > 0.0 ? pairs / seconds : 0.0)
+              << " пар/с, без пары: " << matchmaker.getWaiting()
+              << ", средняя разница рейтингов: " << (pairs ? ratingGap / pairs : 0.0) << std::endl;
+    std::cout << "Ожидание, мс: p50 " << percentile(waits, 0.50) << ", p90 " << percentile(waits, 0.90)
+              << ", p99 " << percentile(waits, 0.99) << ", max " << (waits.empty() ? 0.0 : waits.back()) << std::endl;
+    return 0;
+}
@@ -0,0 +1,252 @@
+#include "Notation.h"              // Подключаем запись ходов и позиций в PDN
+#include "PdnReader.h"             // Подключаем чтение партий из PDN
+#include <chrono>                  // Подключаем часы для измерения времени
+#include <cstdlib>                 // Подключаем std::atoi
+#include <cstring>                 // Подключаем std::strcmp
+#include <iostream>                // Подключаем вывод результатов
+#include <sstream>                 // Подключаем std::istringstream и std::ostringstream для партий PDN
+#include <string>                  // Подключаем std::string
+#include <vector>                  // Подключаем std::vector для записанных партий
+
+//
+// checkers-perft: подсчет листьев дерева допустимых ходов (perft) для проверки генератора ходов Rules.
+// С ключом --check сравнивает perft начальной позиции с опубликованными числами для обоих вариантов
+// и проверяет нотацию: запись и разбор ходов, FEN и чтение партий PDN. Код возврата 1 при любом расхождении,
+// поэтому проверку стоит запускать после каждой правки правил.
+// Использование: checkers-perft [--10x10] [--depth N] [--fen FEN] [--check]
+//
+
+namespace {
+
+// Опубликованные perft начальной позиции (листья на глубине 1, 2, ...)
+const long long RUSSIAN_PERFT[] = { 7, 49, 302, 1469, 7482, 37986, 190146, 929899 };
+const long long INTERNATIONAL_PERFT[] = { 9, 81, 658, 4265, 27117, 167140, 1049442 };
+
+const int NOTATION_DEPTH = 4;      // Глубина обхода, на которой проверяется каждый ход и каждая позиция
+const int PDN_GAMES = 200;         // Сколько случайных партий записывается в PDN и читается обратно
+const int PDN_MAX_PLIES = 150;     // Наибольшая длина случайной партии
+
+// Простой детерминированный генератор случайных чисел, чтобы результаты повторялись от запуска к запуску
+uint32_t nextRandom(uint32_t& state) {
+    state = state * 1664525u + 1013904223u;
+    return state >> 8;
+}
+
+double secondsSince(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class Geometry>
+long long perft(const Position<Geometry>& position, int depth) {
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves);
+    if (depth <= 1) return count;  // Листья не разыгрываем: достаточно числа ходов
+    long long nodes = 0;
+    for (int i = 0; i < count; i++) {
+        Position<Geometry> next = position;
+        Rules<Geometry>::makeMove(next, moves[i]);
+        nodes += perft(next, depth - 1);
+    }
+    return nodes;
+}
+
+template <class Geometry>
+bool samePosition(const Position<Geometry>& a, const Position<Geometry>& b) {
+    return a.sideToMove == b.sideToMove && std::memcmp(a.squares, b.squares, Geometry::SQUARES) == 0;
+}
+
+bool sameMove(const Move& a, const Move& b) {
+    if (a.from != b.from || a.to != b.to || a.captureCount != b.captureCount || a.promotes != b.promotes)
+        return false;
+    for (int i = 0; i < a.captureCount; i++)
+        if (a.path[i] != b.path[i] || a.captured[i] != b.captured[i]) return false;
+    return true;
+}
+
+//
+// Обход дерева: каждая позиция проходит через toFen/parseFen, каждый ход — через moveToString/parseMove.
+// Возвращает число расхождений; первые из них печатаются
+//
+template <class Geometry>
+int checkNotationTree(const Position<Geometry>& position, int depth, long long& checkedMoves) {
+    typedef Notation<Geometry> NotationType;
+    int failures = 0;
+
+    std::string fen = NotationType::toFen(position);
+    Position<Geometry> parsed;
+    if (!NotationType::parseFen(fen, parsed) || !samePosition(parsed, position)) {
+        std::cout << "  FEN не совпадает после разбора: " << fen << std::endl;
+        failures++;
+    }
+
+    Move moves[MAX_MOVES];
+    int count = Rules<Geometry>::generateMoves(position, moves);
+    for (int i = 0; i < count; i++) {
+        checkedMoves++;
+        std::string text = NotationType::moveToString(moves[i]);
+        Move move;
+        if (!NotationType::parseMove(position, text, move) || !sameMove(move, moves[i])) {
+            if (failures < 10) std::cout << "  Ход " << text << " не совпадает после разбора в позиции " << fen << std::endl;
+            failures++;
+        }
+        if (depth > 1) {
+            Position<Geometry> next = position;
+            Rules<Geometry>::makeMove(next, moves[i]);
+            failures += checkNotationTree(next, depth - 1, checkedMoves);
+        }
+    }
+    return failures;
+}
+
+//
+// Случайные партии записываются в PDN (с тегами, номерами ходов и комментариями, половина — с тегом FEN),
+// читаются PdnReader и переигрываются через parseMove; конечная позиция и результат должны совпасть
+//
+template <class Geometry>
+int checkPdn() {
+    typedef Notation<Geometry> NotationType;
+    std::ostringstream pdn;
+    std::vector<Position<Geometry> > finals;
+    std::vector<std::string> results;
+    uint32_t state = 12345;
+
+    for (int game = 0; game < PDN_GAMES; game++) {
+        Position<Geometry> position = Position<Geometry>::initial();
+        Move moves[MAX_MOVES];
+        if (game & 1) {            // Нечетные партии начинаются с позиции после нескольких случайных ходов
+            for (int ply = 0; ply < 6; ply++) {
+                int count = Rules<Geometry>::generateMoves(position, moves);
+                if (count == 0) break;
+                Rules<Geometry>::makeMove(position, moves[nextRandom(state) % count]);
+            }
+        }
+        pdn << "[Event \"perft " << game << "\"]\n";
+        if (game & 1) pdn << "[FEN \"" << NotationType::toFen(position) << "\"]\n";
+        pdn << "\n";
+
+        std::string result = "*";
+        int number = 1;
+        bool whiteToMove = position.sideToMove == white_checker;
+        if (!whiteToMove) pdn << number << "... ";
+        for (int ply = 0; ply < PDN_MAX_PLIES; ply++) {
+            int count = Rules<Geometry>::generateMoves(position, moves);
+            if (count == 0) {      // Сторона без ходов проиграла
+                result = position.sideToMove == white_checker ? "0-2" : "2-0";
+                break;
+            }
+            const Move& move = moves[nextRandom(state) % count];
+            if (position.sideToMove == white_checker) pdn << number << ". ";
+            pdn << NotationType::moveToString(move) << (move.isCapture() ? "! " : " ");
+            if (ply % 10 == 9) pdn << "{ комментарий (с 1-2 внутри) } ";
+            if (position.sideToMove == black_checker) number++;
+            Rules<Geometry>::makeMove(position, move);
+        }
+        if (result == "*" && (game % 3) == 0) result = "1-1";
+        pdn << result << "\n\n";
+        finals.push_back(position);
+        results.push_back(result);
+    }
+
+    std::istringstream input(pdn.str());
+    PdnReader reader(input);
+    PdnGame game;
+    int games = 0;
+    int failures = 0;
+    while (reader.next(game)) {
+        if (games >= PDN_GAMES) {
+            failures++;            // Лишняя партия: читатель разбил запись неправильно
+            break;
+        }
+        Position<Geometry> position = Position<Geometry>::initial();
+        bool valid = game.fen.empty() || NotationType::parseFen(game.fen, position);
+        for (size_t ply = 0; valid && ply < game.moves.size(); ply++) {
+            Move move;
+            valid = NotationType::parseMove(position, game.moves[ply], move);
+            if (valid) Rules<Geometry>::makeMove(position, move);
+        }
+        if (!valid || !samePosition(position, finals[games]) || game.result != results[games]) {
+            if (failures < 10) std::cout << "  Партия " << games << " не совпадает после чтения PDN" << std::endl;
+            failures++;
+        }
+        games++;
+    }
+    if (games != PDN_GAMES) {
+        std::cout << "  Прочитано партий: " << games << " из " << PDN_GAMES << std::endl;
+        failures++;
+    }
+    return failures;
+}
+
+template <class Geometry>
+int runCheck(const long long* expected, int depths) {
+    std::cout << "Доска " << Geometry::SIZE << "x" << Geometry::SIZE << std::endl;
+    int failures = 0;
+    Position<Geometry> start = Position<Geometry>::initial();
+    for (int depth = 1; depth <= depths; depth++) {
+        long long nodes = perft(start, depth);
+        bool ok = nodes == expected[depth - 1];
+        std::cout << "  perft " << depth << ": " << nodes;
+        if (!ok) std::cout << ", ожидалось " << expected[depth - 1];
+        std::cout << (ok ? "" : " — ОШИБКА") << std::endl;
+        if (!ok) failures++;
+    }
+
+    long long checkedMoves = 0;
+    int notationFailures = checkNotationTree(start, NOTATION_DEPTH, checkedMoves);
+    std::cout << "  Нотация ходов и FEN: проверено ходов " << checkedMoves << ", расхождений "
+              << notationFailures << std::endl;
+
+    int pdnFailures = checkPdn<Geometry>();
+    std::cout << "  Чтение PDN: партий " << PDN_GAMES << ", расхождений " << pdnFailures << std::endl;
+    return failures + notationFailures + pdnFailures;
+}
+
+template <class Geometry>
+int runPerft(const char* fen, int depth) {
+    Position<Geometry> position = Position<Geometry>::initial();
+    if (fen && !Notation<Geometry>::parseFen(fen, position)) {
+        std::cout << "Неверная позиция FEN: " << fen << std::endl;
+        return 1;
+    }
+    std::cout << "Доска " << Geometry::SIZE << "x" << Geometry::SIZE << ", позиция "
+              << Notation<Geometry>::toFen(position) << std::endl;
+    for (int d = 1; d <= depth; d++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        long long nodes = perft(position, d);
+        double elapsed = secondsSince(start);
+        std::cout << "  perft " << d << ": " << nodes << ", " << elapsed << " с";
+        if (elapsed > 0.0) std::cout << ", " << static_cast<long long>(nodes / elapsed) << " листьев/с";
+        std::cout << std::endl;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    bool international = false;    // По умолчанию считаем русские шашки 8x8
+    bool check = false;            // Сверка с опубликованными числами и проверка нотации
+    const char* fen = nullptr;
+    int depth = 0;                 // 0 — глубина по умолчанию для варианта
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--10x10") == 0) international = true;
+        else if (std::strcmp(argv[i], "--check") == 0) check = true;
+        else if (std::strcmp(argv[i], "--depth") == 0 && i + 1 < argc) depth = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--fen") == 0 && i + 1 < argc) fen = argv[++i];
+        else {
+            std::cout << "Использование: checkers-perft [--10x10] [--depth N] [--fen FEN] [--check]" << std::endl;
+            return 1;
+        }
+    }
+
+    if (check) {
+        int failures = runCheck<Russian8x8>(RUSSIAN_PERFT, sizeof(RUSSIAN_PERFT) / sizeof(RUSSIAN_PERFT[0])) +
+                       runCheck<International10x10>(INTERNATIONAL_PERFT,
+                                                    sizeof(INTERNATIONAL_PERFT) / sizeof(INTERNATIONAL_PERFT[0]));
+        std::cout << (failures == 0 ? "Все проверки пройдены" : "Есть расхождения") << std::endl;
+        return failures == 0 ? 0 : 1;
+    }
+    if (international)
+        return runPerft<International10x10>(fen, depth > 0 ? depth : 6);
+    return runPerft<Russian8x8>(fen, depth > 0 ? depth : 7);
+}
@@ -0,0 +1,248 @@
+#include "Evaluator.h"             // Подключаем обучаемую оценку позиции
+#include "Notation.h"              // Подключаем разбор ходов и позиций в нотации PDN
+#include "PackedPosition.h"        // Подключаем упакованное представление позиций
+#include "PdnReader.h"             // Подключаем потоковое чтение архива партий
+#include <algorithm>               // Подключаем std::min и std::max
+#include <chrono>                  // Подключаем часы для измерения времени эпох
+#include <cmath>                   // Подключаем std::exp, std::log, std::sqrt
+#include <cstdlib>                 // Подключаем std::atoi и std::atof
+#include <cstring>                 // Подключаем std::strcmp
+#include <fstream>                 // Подключаем чтение файлов архива
+#include <iostream>                // Подключаем вывод статистики
+#include <thread>                  // Подключаем потоки для параллельного вычисления градиента
+#include <vector>                  // Подключаем std::vector
+
+//
+// checkers-tune: подбор весов оценки по результатам партий из архива PDN.
+// Из партий берутся только спокойные позиции (без взятий у стороны, которая ходит), модель обучается
+// градиентным спуском по логистической функции потерь; данные делятся между всеми ядрами процессора.
+//
+// Использование: checkers-tune [--10x10] [--epochs N] [--rate R] [--threads N] [--skip-plies N]
+//                              [--init веса] [--out веса] архив.pdn...
+//
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+// Параметры запуска
+struct TuneOptions {
+    int epochs;                    // Количество эпох
+    double rate;                   // Скорость обучения (шаг Adam)
+    double scale;                  // Коэффициент перевода оценки в вероятность победы
+    int threads;                   // Количество потоков
+    int skipPlies;                 // Сколько первых полуходов партии пропускать (дебют)
+    const char* initPath;          // Начальные веса (nullptr — веса по умолчанию)
+    const char* outPath;           // Файл для сохранения весов
+    std::vector<const char*> archives; // Файлы архивов PDN
+};
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+//
+// Спокойная ли позиция: ни одна фигура стороны, которая ходит, не может бить (проверки Board::canCapture / canKingCapture)
+//
+template <class Geometry>
+bool isQuiet(const Position<Geometry>& position, Board<Geometry>& board) {
+    position.copyToBoard(board);
+    for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+        int piece = position.squares[sq];
+        if (!Rules<Geometry>::isOwn(piece, position.sideToMove)) continue;
+        int x = Position<Geometry>::squareX(sq);
+        int y = Position<Geometry>::squareY(sq);
+        int cell = Position<Geometry>::cellState(piece);
+        bool capture = Rules<Geometry>::isKing(piece) ? board.canKingCapture(x, y, cell) : board.canCapture(x, y, cell);
+        if (capture) return false;
+    }
+    return true;
+}
+
+//
+// Чтение архивов: партии разыгрываются ход за ходом, спокойные позиции упаковываются вместе с результатом партии
+//
+template <class Geometry>
+bool loadPositions(const TuneOptions& options, std::vector<PackedPosition<Geometry> >& positions) {
+    Board<Geometry> board(nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr); // Поле без текстур только для проверок взятий
+    long long games = 0, broken = 0, unknownResult = 0;
+    Clock::time_point start = Clock::now();
+
+    for (size_t a = 0; a < options.archives.size(); a++) {
+        std::ifstream file(options.archives[a]);
+        if (!file) {
+            std::cout << "Не удалось открыть архив: " << options.archives[a] << std::endl;
+            return false;
+        }
+        PdnReader reader(file);
+        PdnGame game;
+        while (reader.next(game)) {
+            games++;
+            double score = game.whiteScore();
+            if (score < 0.0) {     // Партии без результата для обучения бесполезны
+                unknownResult++;
+                continue;
+            }
+            Position<Geometry> position = Position<Geometry>::initial();
+            if (!game.fen.empty() && !Notation<Geometry>::parseFen(game.fen, position)) {
+                broken++;
+                continue;
+            }
+            for (size_t ply = 0; ply < game.moves.size(); ply++) {
+                Move move;
+                if (!Notation<Geometry>::parseMove(position, game.moves[ply], move)) {
+                    broken++;      // Недопустимый ход: остаток партии пропускаем
+                    break;
+                }
+                Rules<Geometry>::makeMove(position, move);
+                if (static_cast<int>(ply) + 1 >= options.skipPlies && isQuiet(position, board))
+                    positions.push_back(PackedPosition<Geometry>::pack(position, score));
+            }
+        }
+    }
+
+    std::cout << "Партий: " << games << ", с ошибками: " << broken << ", без результата: " << unknownResult
+              << ", спокойных позиций: " << positions.size() << " ("
+              << positions.size() * sizeof(PackedPosition<Geometry>) / (1024.0 * 1024.0) << " МБ), чтение "
+              << secondsSince(start) << " с" << std::endl;
+    return !positions.empty();
+}
+
+//
+// Градиент и потери на части данных [begin, end), вычисляемые одним потоком
+//
+template <class Geometry>
+void computeShard(const Evaluator<Geometry>& evaluator, const std::vector<PackedPosition<Geometry> >& positions,
+                  size_t begin, size_t end, double scale, std::vector<double>& gradient, double& loss) {
+    const int BATCH = 256;         // Позиции оцениваются пакетами, чтобы работали SIMD-ядра
+    const int SQUARES = Evaluator<Geometry>::SQUARES;
+    Position<Geometry> batch[BATCH];
+    float scores[BATCH];
+    loss = 0.0;
+    std::fill(gradient.begin(), gradient.end(), 0.0);
+
+    for (size_t first = begin; first < end; first += BATCH) {
+        int count = static_cast<int>(std::min<size_t>(BATCH, end - first));
+        for (int i = 0; i < count; i++)
+            batch[i] = positions[first + i].unpack();
+        evaluator.evaluateBatch(batch, count, scores);
+        for (int i = 0; i < count; i++) {
+            double eval = (batch[i].sideToMove == white_checker) ? scores[i] : -scores[i]; // Оценка с точки зрения белых
+            double p = 1.0 / (1.0 + std::exp(-scale * eval));     // Предсказанная вероятность победы белых
+            double y = positions[first + i].whiteScore();        // Фактический результат партии
+            p = std::min(std::max(p, 1e-12), 1.0 - 1e-12);
+            loss -= y * std::log(p) + (1.0 - y) * std::log(1.0 - p);
+            double g = (p - y) * scale;                           // Производная потерь по оценке
+            for (int sq = 0; sq < Geometry::SQUARES; sq++) {
+                int piece = batch[i].squares[sq];
+                if (piece != piece_none) gradient[piece * SQUARES + sq] += g;
+            }
+            gradient[PIECE_CODES * SQUARES] += g;                 // Свободный член
+        }
+    }
+}
+
+template <class Geometry>
+int tune(const TuneOptions& options) {
+    std::vector<PackedPosition<Geometry> > positions;
+    if (!loadPositions<Geometry>(options, positions)) {
+        std::cout << "Нет позиций для обучения" << std::endl;
+        return 1;
+    }
+
+    Evaluator<Geometry> evaluator;
+    if (options.initPath && !evaluator.loadWeights(options.initPath))
+        return 1;
+
+    const int SQUARES = Evaluator<Geometry>::SQUARES;
+    const size_t parameters = PIECE_CODES * SQUARES + 1;  // Таблицы весов и свободный член
+    const int threads = std::max(1, options.threads);
+    std::vector<std::vector<double> > gradients(threads, std::vector<double>(parameters));
+    std::vector<double> losses(threads);
+    std::vector<double> moment(parameters, 0.0), velocity(parameters, 0.0); // Состояние оптимизатора Adam
+    const double beta1 = 0.9, beta2 = 0.999, epsilon = 1e-8;
+
+    std::cout << "Обучение: " << positions.size() << " позиций, потоков: " << threads
+              << ", ядро оценки: " << Evaluator<Geometry>::kernelName(evaluator.getKernel()) << std::endl;
+
+    for (int epoch = 1; epoch <= options.epochs; epoch++) {
+        Clock::time_point start = Clock::now();
+
+        // Каждый поток считает градиент на своей части данных
+        std::vector<std::thread> workers;
+        size_t shard = (positions.size() + threads - 1) / threads;
+        for (int t = 0; t < threads; t++) {
+            size_t begin = std::min(positions.size(), t * shard);
+            size_t end = std::min(positions.size(), begin + shard);
+            workers.push_back(std::thread(computeShard<Geometry>, std::cref(evaluator), std::cref(positions),
+                                          begin, end, options.scale, std::ref(gradients[t]), std::ref(losses[t])));
+        }
+        for (size_t t = 0; t < workers.size(); t++)
+            workers[t].join();
+
+        // Сводим результаты потоков и делаем шаг Adam
+        double loss = 0.0;
+        for (int t = 0; t < threads; t++) loss += losses[t];
+        loss /= positions.size();
+        double correction1 = 1.0 - std::pow(beta1, epoch);
+        double correction2 = 1.0 - std::pow(beta2, epoch);
+        for (size_t k = 0; k < parameters; k++) {
+            int piece = static_cast<int>(k / SQUARES);
+            int sq = static_cast<int>(k % SQUARES);
+            bool isBias = (k == parameters - 1);
+            if (!isBias && (piece == piece_none || sq >= Geometry::SQUARES)) continue; // Пустые клетки и дополнение не обучаются
+            double g = 0.0;
+            for (int t = 0; t < threads; t++) g += gradients[t][k];
+            g /= positions.size();
+            moment[k] = beta1 * moment[k] + (1.0 - beta1) * g;
+            velocity[k] = beta2 * velocity[k] + (1.0 - beta2) * g * g;
+            double step = options.rate * (moment[k] / correction1) / (std::sqrt(velocity[k] / correction2) + epsilon);
+            if (isBias) evaluator.setBias(static_cast<float>(evaluator.getBias() - step));
+            else evaluator.setWeight(piece, sq, static_cast<float>(evaluator.getWeight(piece, sq) - step));
+        }
+
+        double elapsed = secondsSince(start);
+        std::cout << "Эпоха " << epoch << ": потери " << loss << ", время " << elapsed << " с, "
+                  << static_cast<long long>(positions.size() / elapsed) << " позиций/с" << std::endl;
+
+        if (!evaluator.saveWeights(options.outPath)) // Сохраняем после каждой эпохи, чтобы длинный запуск можно было прервать
+            return 1;
+    }
+    std::cout << "Веса сохранены в " << options.outPath << std::endl;
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    TuneOptions options;
+    options.epochs = 100;
+    options.rate = 1.0;
+    options.scale = std::log(10.0) / 400.0;   // Преимущество в 400 единиц оценки — шансы 10:1
+    options.threads = static_cast<int>(std::thread::hardware_concurrency());
+    options.skipPlies = 8;
+    options.initPath = nullptr;
+    options.outPath = "weights.bin";
+    bool international = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--10x10") == 0) international = true;
+        else if (std::strcmp(argv[i], "--epochs") == 0 && i + 1 < argc) options.epochs = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--rate") == 0 && i + 1 < argc) options.rate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--skip-plies") == 0 && i + 1 < argc) options.skipPlies = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--init") == 0 && i + 1 < argc) options.initPath = argv[++i];
+        else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) options.outPath = argv[++i];
+        else options.archives.push_back(argv[i]);
+    }
+    if (options.archives.empty()) {
+        std::cout << "Использование: checkers-tune [--10x10] [--epochs N] [--rate R] [--threads N] [--skip-plies N]"
+                     " [--init веса] [--out веса] архив.pdn..." << std::endl;
+        return 1;
+    }
+    if (options.threads <= 0) options.threads = 1;
+
+    if (international)
+        return tune<International10x10>(options);
+    return tune<Russian8x8>(options);
+}